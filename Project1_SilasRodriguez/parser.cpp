@@ -1,95 +0,0 @@
-/*
-=============================================================================
-Title : parser.cpp
-Description : This is part of a syntax analyzer program.
-Author : silrodri (R#11679913)
-Date : 10/19/2023
-Version : 1.0
-Usage : Compile and run this program using 'make' and ./dcooke_analyzer [file]
-Notes : This program is dependent on the lexical analyzer program (main.cpp / dcooke_analyzer).
-C++ Version : cpp (GCC) 4.8.5 20150623 (Red Hat 4.8.5-16)
-=============================================================================
-*/
-#include <iostream>
-#include "parser.h"
-#include "front.h"
-
-static void error();
-
-/* expr
- * Parses strings in the language generated by the rule:
- * <expr> -> <term> {(+ | -) <term>}
- */
-void expr()
-{
-    std::cout << "Enter <expr>" << std::endl;
-
-    /* Parse the first term */
-    term();
-
-    /* As long as the next token is + or -, get
-    the next token and parse the next term */
-    while (nextToken == ADD_OP || nextToken == SUB_OP)
-    {
-        lex();
-        term();
-    }
-
-    std::cout << "Exit <expr>" << std::endl;
-} /* End of function expr */
-
-/* term
- * Parses strings in the language generated by the rule:
- * <term> -> <factor> {(* | /) <factor>)
- */
-void term()
-{
-    std::cout << "Enter <term>" << std::endl;
-    /* Parse the first factor */
-    factor();
-    /* As long as the next token is * or /, get the
-    next token and parse the next factor */
-    while (nextToken == MULT_OP || nextToken == DIV_OP)
-    {
-        lex();
-        factor();
-    }
-    std::cout << "Exit <term>" << std::endl;
-} /* End of function term */
-
-/* factor
- * Parses strings in the language generated by the rule:
- * <factor> -> id | int_constant | ( <expr )
- */
-void factor()
-{
-    std::cout << "Enter <factor>" << std::endl;
-    /* Determine which RHS */
-    if (nextToken == IDENT || nextToken == INT_LIT)
-        lex(); /* Get the next token */
-    else
-    {
-        /* If the RHS is (<expr>), call lex to pass over the
-        left parenthesis, call expr, and check for the right
-        parenthesis */
-        if (nextToken == LEFT_PAREN)
-        {
-            lex();
-            expr();
-
-            if (nextToken == RIGHT_PAREN)
-                lex();
-            else
-                error();
-        } /* End of if (nextToken == ... */
-        /* It was not an id, an integer literal, or a left parenthesis */
-        else
-            error();
-    } /* End of else */
-    std::cout << "Exit <factor>" << std::endl;
-} /* End of function factor */
-
-static void error()
-{
-    std::cout << "Error (more is desired, but not implemented)." << std::endl;
-}
@@ -0,0 +1,171 @@
+/*
+=============================================================================
+Title : allocstats.cpp
+Description : Heap allocation accounting per phase (--alloc-stats).
+Author : silrodri (R#11679913)
+Date : 10/19/2026
+Version : 2.0
+Usage : Linked into dcooke_parser; the hooks are only compiled in with
+        'make clean && make ALLOC_STATS=1' (-DDC_ALLOC_STATS)
+Notes : Replaces the global operator new/delete and, on glibc, malloc,
+        calloc, realloc and free, so allocations made inside libdcooke and
+        the standard library are counted too. Every allocation is charged
+        to the phase set last with allocPhase() in the current pass. The cold pass is
+        the real run; the steady pass repeats it on the same context, where
+        a run that reuses its buffers should allocate nothing per token.
+C++ Version : cpp (GCC) 4.8.5 20150623 (Red Hat 4.8.5-16)
+=============================================================================
+*/
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#include "frontend.h"
+
+static const char *const phaseNames[ALLOC_PHASES] = {"other", "lex", "parse", "report"};
+
+static std::atomic<unsigned long long> counts[ALLOC_PASSES][ALLOC_PHASES];
+static std::atomic<unsigned long long> bytes[ALLOC_PASSES][ALLOC_PHASES];
+static std::atomic<int> current; // pass * ALLOC_PHASES + phase
+static int pass;                 // ALLOC_COLD until allocPass()
+
+#ifdef DC_ALLOC_STATS
+static void charge(size_t size)
+{
+    int at = current.load(std::memory_order_relaxed);
+    counts[at / ALLOC_PHASES][at % ALLOC_PHASES].fetch_add(1, std::memory_order_relaxed);
+    bytes[at / ALLOC_PHASES][at % ALLOC_PHASES].fetch_add(size, std::memory_order_relaxed);
+}
+
+#ifdef __GLIBC__
+// the real allocator behind the replaced entry points
+extern "C" void *__libc_malloc(size_t size);
+extern "C" void *__libc_calloc(size_t n, size_t size);
+extern "C" void *__libc_realloc(void *p, size_t size);
+extern "C" void __libc_free(void *p);
+
+extern "C" void *malloc(size_t size)
+{
+    charge(size);
+    return __libc_malloc(size);
+}
+
+extern "C" void *calloc(size_t n, size_t size)
+{
+    charge(n * size);
+    return __libc_calloc(n, size);
+}
+
+extern "C" void *realloc(void *p, size_t size)
+{
+    charge(size);
+    return __libc_realloc(p, size);
+}
+
+extern "C" void free(void *p)
+{
+    __libc_free(p);
+}
+#define RAW_MALLOC __libc_malloc
+#define RAW_FREE __libc_free
+#else
+#define RAW_MALLOC malloc
+#define RAW_FREE free
+#endif
+
+/**
+ * @brief operator new goes straight to the real allocator, so it is
+ *  counted once even where malloc is hooked as well
+ */
+static void *counted(size_t size)
+{
+    charge(size);
+    void *p = RAW_MALLOC(size ? size : 1);
+    if (p == nullptr)
+        throw std::bad_alloc();
+    return p;
+}
+
+void *operator new(size_t size)
+{
+    return counted(size);
+}
+
+void *operator new[](size_t size)
+{
+    return counted(size);
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept
+{
+    try
+    {
+        return counted(size);
+    }
+    catch (const std::bad_alloc &)
+    {
+        return nullptr;
+    }
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept
+{
+    return operator new(size, std::nothrow);
+}
+
+void operator delete(void *p) noexcept
+{
+    RAW_FREE(p);
+}
+
+void operator delete[](void *p) noexcept
+{
+    RAW_FREE(p);
+}
+#endif
+
+bool allocAvailable()
+{
+#ifdef DC_ALLOC_STATS
+    return true;
+#else
+    return false;
+#endif
+}
+
+void allocPass(int which)
+{
+    pass = which;
+    current.store(pass * ALLOC_PHASES + ALLOC_OTHER, std::memory_order_relaxed);
+}
+
+void allocPhase(int phase)
+{
+    current.store(pass * ALLOC_PHASES + phase, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Format the per-phase table and the steady-state rate per token
+ */
+void allocReport(size_t tokens, std::string *out)
+{
+    char line[160];
+    unsigned long long steady = 0;
+
+    snprintf(line, sizeof line, "heap allocations\n%-10s %12s %14s %12s %14s\n", "phase",
+             "cold", "cold bytes", "steady", "steady bytes");
+    *out += line;
+    for (int p = 0; p < ALLOC_PHASES; p++)
+    {
+        snprintf(line, sizeof line, "%-10s %12llu %14llu %12llu %14llu\n", phaseNames[p],
+                 counts[ALLOC_COLD][p].load(), bytes[ALLOC_COLD][p].load(),
+                 counts[ALLOC_STEADY][p].load(), bytes[ALLOC_STEADY][p].load());
+        *out += line;
+    }
+    for (int p = ALLOC_LEX; p <= ALLOC_PARSE; p++)
+        steady += counts[ALLOC_STEADY][p].load();
+    snprintf(line, sizeof line, "steady lex+parse: %llu allocations for %zu tokens (%.4f per token)\n",
+             steady, tokens, tokens ? (double)steady / tokens : 0.0);
+    *out += line;
+}
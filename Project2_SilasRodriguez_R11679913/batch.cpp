@@ -0,0 +1,115 @@
+/*
+=============================================================================
+Title : batch.cpp
+Description : Corpus mode of dcooke_parser: validate many files at once.
+Author : silrodri (R#11679913)
+Date : 10/19/2026
+Version : 2.0
+Usage : ./dcooke_parser [options] <file1> <file2> ...
+Notes : Files are loaded by dc_ingest (io_uring where available) and parsed
+        on its worker pool; results are printed in command-line order.
+C++ Version : cpp (GCC) 4.8.5 20150623 (Red Hat 4.8.5-16)
+=============================================================================
+*/
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+#include "frontend.h"
+
+using std::cerr;
+using std::cout;
+using std::endl;
+
+/**
+ * @brief Prefix every line of text with "path: "
+ */
+std::string prefixed(const char *path, const std::string &text)
+{
+    std::string res;
+    size_t at = 0, nl;
+    while ((nl = text.find('\n', at)) != std::string::npos)
+    {
+        res += std::string(path) + ": " + text.substr(at, nl + 1 - at);
+        at = nl + 1;
+    }
+    return res;
+}
+
+/**
+ * @brief dc_ingest callback: validate one loaded file on a worker
+ */
+static void onFile(void *user, unsigned worker, size_t index, const char *data, size_t len, int err)
+{
+    dc_batch *b = (dc_batch *)user;
+    const char *path = (*b->files)[index];
+
+    if (err != 0)
+    {
+        b->codes[index] = FileNotFound;
+        b->errs[index] = std::string(path) + ": EXIT CODE (" + std::to_string(FileNotFound) +
+                         "): cannot open " + path + " (" + strerror(err) + ")\n";
+        return;
+    }
+    std::string out, errText;
+    b->codes[index] = validate(b->contexts[worker], *b->opt, data, len, &out, &errText);
+    b->outs[index] = prefixed(path, out);
+    b->errs[index] = prefixed(path, errText);
+}
+
+/**
+ * @brief Validate b->files on one worker per context; fills in the codes,
+ *  outs and errs. Returns what dc_ingest returned, 0 for no files
+ */
+int validateFiles(dc_batch *b)
+{
+    const std::vector<const char *> &files = *b->files;
+    b->codes.assign(files.size(), NoError);
+    b->outs.assign(files.size(), std::string());
+    b->errs.assign(files.size(), std::string());
+    if (files.empty())
+        return 0;
+    return dc_ingest(&files[0], files.size(), (unsigned)b->contexts.size(), b->opt->ingest,
+                     onFile, b);
+}
+
+/**
+ * @brief Validate every file; the exit code is the highest exitCode seen
+ */
+int runBatch(const dc_options &opt, const std::vector<const char *> &files)
+{
+    dc_batch b;
+    unsigned workers = opt.jobs ? opt.jobs : std::max(1u, std::thread::hardware_concurrency());
+
+    b.opt = &opt;
+    b.files = &files;
+    for (unsigned w = 0; w < workers; w++)
+        b.contexts.push_back(dc_create());
+
+    int used = validateFiles(&b);
+    for (unsigned w = 0; w < workers; w++)
+        dc_destroy(b.contexts[w]);
+    if (used < 0)
+    {
+        cerr << "Error - io_uring is not available on this system" << endl;
+        return FileNotFound;
+    }
+
+    int worst = NoError;
+    size_t passed = 0;
+    for (size_t i = 0; i < files.size(); i++)
+    {
+        cerr << b.errs[i];
+        cout << b.outs[i];
+        if (b.codes[i] == NoError)
+            passed++;
+        worst = std::max(worst, (int)b.codes[i]);
+    }
+    cout << passed << " of " << files.size() << " files validated ("
+         << (used == DC_INGEST_URING ? "io_uring" : "threads");
+    if (opt.cache)
+        cout << ", " << opt.cache->hits << " from the cache";
+    cout << ")" << endl;
+    return worst;
+}
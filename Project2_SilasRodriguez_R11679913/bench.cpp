@@ -0,0 +1,184 @@
+/*
+=============================================================================
+Title : bench.cpp
+Description : dcooke_bench, times dc_parse against dc_parse_pipelined,
+              and the dc_fleet scheduler with many instances.
+Author : silrodri (R#11679913)
+Date : 10/19/2026
+Version : 2.0
+Usage : make dcooke_bench && ./dcooke_bench [--reps=N] <inputFile>...
+        ./dcooke_bench --fleet=N <inputFile>...
+Notes : Each file is loaded once and parsed --reps times (default 5) in
+        each mode; the best time of each is reported. The pipeline needs a
+        second core to win: on one CPU the two threads take turns.
+        --fleet spawns N instances of each program and runs them until
+        all wait in read(), then feeds instance i the value i % 1000,
+        ends its input and runs them to the end.
+C++ Version : cpp (GCC) 4.8.5 20150623 (Red Hat 4.8.5-16)
+=============================================================================
+*/
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "dcooke.h"
+
+/**
+ * @brief Best wall time in seconds of reps parses of src
+ */
+static double bestOf(dc_context *ctx, const std::string &src, int reps, bool pipelined,
+                     exitCode *result)
+{
+    double best = 1e30;
+    for (int r = 0; r < reps; r++)
+    {
+        dc_reset(ctx);
+        dc_feed(ctx, src.data(), src.size());
+        std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+        *result = pipelined ? dc_parse_pipelined(ctx) : dc_parse(ctx);
+        std::chrono::duration<double> took = std::chrono::steady_clock::now() - t0;
+        if (took.count() < best)
+            best = took.count();
+    }
+    return best;
+}
+
+/**
+ * @brief : What the --fleet callbacks count
+ */
+struct dc_fleetstats
+{
+    size_t writes;
+    size_t exits[RuntimeError + 1];
+};
+
+static void countWrite(void *user, long, long long)
+{
+    ((dc_fleetstats *)user)->writes++;
+}
+
+static void countExit(void *user, long, exitCode code, const char *)
+{
+    ((dc_fleetstats *)user)->exits[code]++;
+}
+
+/**
+ * @brief Resident memory in MB, from /proc/self/statm
+ */
+static double residentMB()
+{
+    FILE *statm_fp = fopen("/proc/self/statm", "r");
+    unsigned long size = 0, resident = 0;
+    if (statm_fp == nullptr)
+        return 0;
+    if (fscanf(statm_fp, "%lu %lu", &size, &resident) != 2)
+        resident = 0;
+    fclose(statm_fp);
+    return resident * (sysconf(_SC_PAGESIZE) / 1e6);
+}
+
+static double secondsSince(std::chrono::steady_clock::time_point t0)
+{
+    std::chrono::duration<double> took = std::chrono::steady_clock::now() - t0;
+    return took.count();
+}
+
+/**
+ * @brief --fleet: n instances of the program in ctx on one dc_fleet
+ */
+static void fleetBench(dc_context *ctx, const char *name, long n)
+{
+    dc_fleetstats stats = dc_fleetstats();
+    dc_fleet_io io = {countWrite, nullptr, countExit, &stats};
+    dc_fleet *fleet = dc_fleet_create(&io, 0, 0);
+    double before = residentMB();
+
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    for (long i = 0; i < n; i++)
+        dc_fleet_spawn(fleet, ctx);
+    size_t waiting = dc_fleet_run(fleet);
+    double started = secondsSince(t0);
+    double grown = residentMB() - before;
+
+    t0 = std::chrono::steady_clock::now();
+    for (long i = 0; i < n; i++)
+    {
+        dc_fleet_feed(fleet, i, i % 1000);
+        dc_fleet_end_input(fleet, i);
+    }
+    dc_fleet_run(fleet);
+    double finished = secondsSince(t0);
+    dc_fleet_destroy(fleet);
+
+    printf("%-24s %8ld instances: %zu waiting after %.3fs (%.0f bytes each), "
+           "done %.3fs later\n",
+           name, n, waiting, started, n ? grown * 1e6 / n : 0.0, finished);
+    printf("%-24s %8zu writes, %zu ok, %zu runtime errors, %zu over the limit\n", "",
+           stats.writes, stats.exits[NoError], stats.exits[RuntimeError],
+           stats.exits[LimitExceeded]);
+}
+
+int main(int argc, char **argv)
+{
+    int reps = 5;
+    long fleet = 0;
+    std::vector<const char *> files;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strncmp(argv[i], "--reps=", 7) == 0)
+            reps = atoi(argv[i] + 7) > 0 ? atoi(argv[i] + 7) : 1;
+        else if (strncmp(argv[i], "--fleet=", 8) == 0)
+            fleet = atol(argv[i] + 8);
+        else
+            files.push_back(argv[i]);
+    }
+    if (files.empty())
+    {
+        fprintf(stderr, "Usage: %s [--reps=N | --fleet=N] <inputFile>...\n", argv[0]);
+        return 1;
+    }
+
+    dc_context *ctx = dc_create();
+    if (fleet == 0)
+        printf("%-24s %10s %12s %12s %8s\n", "file", "MB", "dc_parse", "pipelined", "speedup");
+    for (size_t f = 0; f < files.size(); f++)
+    {
+        FILE *in_fp = fopen(files[f], "rb");
+        char buf[BUFSIZ];
+        size_t n;
+        std::string src;
+        if (in_fp == nullptr)
+        {
+            fprintf(stderr, "cannot open %s\n", files[f]);
+            continue;
+        }
+        while ((n = fread(buf, 1, sizeof buf, in_fp)) > 0)
+            src.append(buf, n);
+        fclose(in_fp);
+
+        exitCode a, b;
+        if (fleet > 0)
+        {
+            dc_reset(ctx);
+            dc_feed(ctx, src.data(), src.size());
+            if (dc_parse(ctx) != NoError)
+                fprintf(stderr, "%s: not a valid program\n", files[f]);
+            else
+                fleetBench(ctx, files[f], fleet);
+            continue;
+        }
+        double mb = src.size() / 1e6;
+        double plain = bestOf(ctx, src, reps, false, &a);
+        double piped = bestOf(ctx, src, reps, true, &b);
+        printf("%-24s %10.2f %9.1f MB/s %7.1f MB/s %7.2fx%s\n", files[f], mb, mb / plain,
+               mb / piped, plain / piped, a == b ? "" : "  (results differ!)");
+    }
+    dc_destroy(ctx);
+    return 0;
+}
@@ -0,0 +1,332 @@
+/*
+=============================================================================
+Title : frontend.cpp
+Description : Shared helpers of the dcooke_parser front-end.
+Author : silrodri (R#11679913)
+Date : 10/19/2026
+Version : 2.0
+Usage : Linked into dcooke_parser
+Notes : This program is dependent on libdcooke (../libdcooke). --cache
+        keeps what validate() printed with token numbers in place of line
+        and column numbers, which only hold for one layout. Results are
+        keyed by the SHA-256 of the tokens, not the 64-bit hash, since a
+        served or cached source may be built to collide. A source with
+        the same tokens gets them back from its own token positions, so a
+        hit costs a scan for the digest and, when the text has positions, a
+        second one for the tokens; never the parse or the analyses.
+C++ Version : cpp (GCC) 4.8.5 20150623 (Red Hat 4.8.5-16)
+=============================================================================
+*/
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+
+#include "frontend.h"
+
+#define TOKEN_OPEN '\x01'  // starts a token number in a cached text
+#define TOKEN_CLOSE '\x02' // and ends it
+#define CACHE_MAGIC "dcooke-cache 2"
+
+typedef std::map<std::pair<size_t, size_t>, size_t> dc_starts; // line, column -> token
+
+/**
+ * @brief The options that change what validate() prints, as text with no
+ *  blanks (the cache file reads it as one word)
+ */
+static std::string optionKey(const dc_options &opt)
+{
+    const unsigned long long parts[] = {opt.warnUninit, opt.analyze, opt.parallelize,
+                                        opt.closedForm, opt.limited, opt.limits.maxDepth,
+                                        opt.limits.maxTokenLength, opt.limits.maxTokens,
+                                        opt.limits.maxDiags};
+    std::string key;
+    for (size_t i = 0; i < sizeof parts / sizeof *parts; i++)
+        key += (i ? "," : "") + std::to_string(parts[i]);
+    return key;
+}
+
+/**
+ * @brief The dc_token_digest() of the last dc_format, in hex
+ */
+static std::string digestKey(const dc_context *ctx)
+{
+    unsigned char digest[32];
+    char hex[2 * sizeof digest + 1];
+    dc_token_digest(ctx, digest);
+    for (size_t i = 0; i < sizeof digest; i++)
+        snprintf(hex + 2 * i, 3, "%02x", digest[i]);
+    return hex;
+}
+
+/**
+ * @brief Replace each " at line L, column C" of text by the number of the
+ *  token that starts there; false when a position is not a token start
+ */
+static bool unplace(dc_context *ctx, dc_starts *starts, std::string *text, bool *placed)
+{
+    static const char at[] = " at line ";
+    std::string done;
+    size_t from = 0, p, line, column;
+    int used;
+
+    if (text->find(TOKEN_OPEN) != std::string::npos || text->find(TOKEN_CLOSE) != std::string::npos)
+        return false;
+    while ((p = text->find(at, from)) != std::string::npos)
+    {
+        used = 0;
+        if (sscanf(text->c_str() + p, " at line %zu, column %zu%n", &line, &column, &used) != 2 ||
+            used == 0)
+        {
+            done.append(*text, from, p + 1 - from);
+            from = p + 1;
+            continue;
+        }
+        if (starts->empty())
+            for (size_t i = 0; i < dc_token_count(ctx); i++)
+            {
+                size_t l, c;
+                if (dc_locate(ctx, dc_token_offset(ctx, i), &l, &c) == 0)
+                    (*starts)[std::make_pair(l, c)] = i;
+            }
+        dc_starts::const_iterator it = starts->find(std::make_pair(line, column));
+        if (it == starts->end())
+            return false;
+        done.append(*text, from, p - from);
+        done += TOKEN_OPEN;
+        done += std::to_string(it->second);
+        done += TOKEN_CLOSE;
+        from = p + used;
+        *placed = true;
+    }
+    done.append(*text, from, std::string::npos);
+    text->swap(done);
+    return true;
+}
+
+/**
+ * @brief Put back the positions unplace() took out, from the tokens of the
+ *  source in ctx; false when a token number is past them
+ */
+static bool place(dc_context *ctx, const std::string &text, std::string *out)
+{
+    size_t from = 0, p, line, column;
+    char at[64];
+
+    out->clear();
+    while ((p = text.find(TOKEN_OPEN, from)) != std::string::npos)
+    {
+        size_t token = strtoull(text.c_str() + p + 1, nullptr, 10);
+        if (token >= dc_token_count(ctx) ||
+            dc_locate(ctx, dc_token_offset(ctx, token), &line, &column) != 0)
+            return false;
+        out->append(text, from, p - from);
+        snprintf(at, sizeof at, " at line %zu, column %zu", line, column);
+        *out += at;
+        from = text.find(TOKEN_CLOSE, p) + 1;
+    }
+    out->append(text, from, std::string::npos);
+    return true;
+}
+
+/**
+ * @brief Validate one source buffer with a (reused) context
+ *
+ * @param data : source text, or nullptr to parse the source attached to ctx
+ * @param out : receives syntax errors and the final "Syntax ..." line
+ * @param err : receives lexical, limit and warning diagnostics
+ * @return exitCode : result of the parse
+ */
+exitCode validate(dc_context *ctx, const dc_options &opt, const char *data, size_t len,
+                  std::string *out, std::string *err)
+{
+    std::ostringstream o, e;
+    bool keyed = opt.cache && !opt.perf && !opt.allocStats;
+    dc_cache_key key;
+
+    // without data, the caller has attached a source with dc_set_source()
+    if (data != nullptr)
+    {
+        dc_reset(ctx);
+        dc_feed(ctx, data, len);
+    }
+    if (opt.limited)
+        dc_set_limits(ctx, &opt.limits);
+    // a scan for the token digest, which a hit saves the parse and analyses
+    if (keyed)
+    {
+        dc_cached hit;
+        bool found;
+        dc_format(ctx, nullptr);
+        key = std::make_pair(digestKey(ctx), optionKey(opt));
+        {
+            std::lock_guard<std::mutex> hold(opt.cache->lock);
+            std::map<dc_cache_key, dc_cached>::iterator it = opt.cache->results.find(key);
+            found = it != opt.cache->results.end();
+            if (found)
+                hit = it->second;
+        }
+        // positions come from the tokens of this source
+        if (found && hit.placed)
+        {
+            dc_tokenize(ctx);
+            found = place(ctx, hit.out, out) && place(ctx, hit.err, err);
+        }
+        else if (found)
+        {
+            *out = hit.out;
+            *err = hit.err;
+        }
+        if (found)
+        {
+            std::lock_guard<std::mutex> hold(opt.cache->lock);
+            opt.cache->hits++;
+            return hit.code;
+        }
+    }
+    // dc_parse() lexes on demand, so lex alone to split the counts; the
+    // first pass only warms the token arrays so neither phase pays for that
+    if (opt.perf)
+    {
+        dc_tokenize(ctx);
+        perfBegin(opt.perf);
+        dc_tokenize(ctx);
+        perfEnd(opt.perf, PERF_LEX);
+        perfBegin(opt.perf);
+    }
+    // like the counters above, charge the scan alone to lex
+    if (opt.allocStats)
+    {
+        allocPhase(ALLOC_LEX);
+        dc_tokenize(ctx);
+        allocPhase(ALLOC_PARSE);
+    }
+    exitCode exit_code = opt.pipeline ? dc_parse_pipelined(ctx) : dc_parse(ctx);
+    if (opt.allocStats)
+        allocPhase(ALLOC_REPORT);
+    if (opt.perf)
+    {
+        perfEnd(opt.perf, PERF_PARSE);
+        perfExclude(opt.perf, PERF_PARSE, PERF_LEX);
+    }
+    if (opt.warnUninit)
+        dc_warn_uninit(ctx);
+    if (opt.analyze)
+        dc_analyze(ctx);
+    // after the analyses, which describe the program as written
+    if (opt.parallelize)
+        dc_parallelize(ctx);
+    if (opt.closedForm)
+        dc_close_loops(ctx);
+    for (size_t i = 0; i < dc_diag_count(ctx); i++)
+    {
+        if (dc_diag_kind_at(ctx, i) != DC_DIAG_SYNTAX)
+            e << dc_diag_message(ctx, i) << "\n";
+        else
+            o << dc_diag_message(ctx, i) << "\n";
+    }
+
+    if (exit_code == NoError)
+        o << "Syntax Validated: Exit(" << exit_code << ")\n";
+    else
+        o << "Syntax Not Validated: Exit(" << exit_code << ")\n";
+    *out = o.str();
+    *err = e.str();
+    if (keyed)
+    {
+        dc_cached result;
+        dc_starts starts;
+        result.code = exit_code;
+        result.out = *out;
+        result.err = *err;
+        result.placed = false;
+        if (unplace(ctx, &starts, &result.out, &result.placed) &&
+            unplace(ctx, &starts, &result.err, &result.placed))
+        {
+            std::lock_guard<std::mutex> hold(opt.cache->lock);
+            if (opt.cache->results.size() < CACHE_MAX)
+                opt.cache->results[key] = result;
+        }
+    }
+    if (opt.allocStats)
+        allocPhase(ALLOC_OTHER);
+    return exit_code;
+}
+
+/**
+ * @brief Add the results saved by cacheSave() at path; no file, or one of
+ *  another version, is an empty cache. Returns 0, or -1 when the file cannot be read
+ */
+int cacheLoad(dc_cache *cache, const char *path)
+{
+    FILE *fp = fopen(path, "rb");
+    char head[32], digest[65], options[256];
+    int code, placed, rc = 0;
+    size_t outLen, errLen;
+
+    if (fp == nullptr)
+        return errno == ENOENT ? 0 : -1;
+    if (fgets(head, sizeof head, fp) == nullptr || strncmp(head, "dcooke-cache ", 13) != 0)
+        rc = -1;
+    else if (strcmp(head, CACHE_MAGIC "\n") != 0)
+    {
+        fclose(fp);
+        return 0; // another version's keys; the next save replaces them
+    }
+    while (rc == 0 && fscanf(fp, "%64s %255s %d %d %zu %zu", digest, options, &code, &placed,
+                             &outLen, &errLen) == 6)
+    {
+        dc_cached c;
+        c.code = (exitCode)code;
+        c.placed = placed != 0;
+        c.out.resize(outLen);
+        c.err.resize(errLen);
+        if (fgetc(fp) != '\n' || fread(&c.out[0], 1, outLen, fp) != outLen ||
+            fread(&c.err[0], 1, errLen, fp) != errLen)
+        {
+            rc = -1;
+            break;
+        }
+        std::lock_guard<std::mutex> hold(cache->lock);
+        if (cache->results.size() < CACHE_MAX)
+            cache->results[std::make_pair(std::string(digest), std::string(options))] = c;
+    }
+    if (rc == 0 && !feof(fp))
+        rc = -1;
+    fclose(fp);
+    return rc;
+}
+
+/**
+ * @brief Write every result to path, through a temporary file so a reader
+ *  never sees half of it. Returns 0, or -1 when it cannot be written
+ */
+int cacheSave(dc_cache *cache, const char *path)
+{
+    std::string tmp = std::string(path) + ".tmp";
+    FILE *fp = fopen(tmp.c_str(), "wb");
+    if (fp == nullptr)
+        return -1;
+    bool failed = fprintf(fp, CACHE_MAGIC "\n") < 0;
+    {
+        std::lock_guard<std::mutex> hold(cache->lock);
+        std::map<dc_cache_key, dc_cached>::const_iterator it;
+        for (it = cache->results.begin(); it != cache->results.end(); ++it)
+        {
+            const dc_cached &c = it->second;
+            failed |= fprintf(fp, "%s %s %d %d %zu %zu\n", it->first.first.c_str(),
+                              it->first.second.c_str(), (int)c.code, c.placed ? 1 : 0,
+                              c.out.size(), c.err.size()) < 0;
+            failed |= fwrite(c.out.data(), 1, c.out.size(), fp) != c.out.size();
+            failed |= fwrite(c.err.data(), 1, c.err.size(), fp) != c.err.size();
+        }
+    }
+    failed |= fclose(fp) != 0;
+    if (failed || rename(tmp.c_str(), path) != 0)
+    {
+        remove(tmp.c_str());
+        return -1;
+    }
+    return 0;
+}
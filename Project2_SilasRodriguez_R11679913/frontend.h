@@ -0,0 +1,136 @@
+/*
+=============================================================================
+Title : frontend.h
+Description : Options and shared helpers of the dcooke_parser front-end.
+Author : silrodri (R#11679913)
+Date : 10/19/2026
+Version : 2.0
+Usage : Imported into main.cpp and the per-mode sources (batch.cpp, ...)
+Notes : This program is dependent on libdcooke (../libdcooke).
+C++ Version : cpp (GCC) 4.8.5 20150623 (Red Hat 4.8.5-16)
+=============================================================================
+*/
+#ifndef FRONTEND_H
+#define FRONTEND_H
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "dcooke.h"
+
+/* Phases timed by --perf-counters */
+#define PERF_IO 0
+#define PERF_LEX 1
+#define PERF_PARSE 2
+#define PERF_PHASES 3
+
+/* Passes and phases charged by --alloc-stats */
+#define ALLOC_COLD 0
+#define ALLOC_STEADY 1
+#define ALLOC_PASSES 2
+#define ALLOC_OTHER 0
+#define ALLOC_LEX 1
+#define ALLOC_PARSE 2
+#define ALLOC_REPORT 3
+#define ALLOC_PHASES 4
+
+struct dc_perf;
+
+#define CACHE_MAX 65536 // results kept by --cache
+
+/**
+ * @brief : A cached validation: the exit code and what validate() printed,
+ *  with every " at line L, column C" replaced by the number of the token
+ *  there, so it holds for any layout of the same tokens
+ */
+struct dc_cached
+{
+    exitCode code;
+    std::string out, err;
+    bool placed; // out or err name tokens
+};
+
+/* --cache key: the hex dc_token_digest() and the options that change the
+ * result, spelled out; both are compared in full, so a hit cannot be forged */
+typedef std::pair<std::string, std::string> dc_cache_key;
+
+/**
+ * @brief : --cache: results by token digest and options
+ */
+struct dc_cache
+{
+    std::mutex lock; // batch workers share it
+    std::map<dc_cache_key, dc_cached> results;
+    size_t hits;
+};
+
+/**
+ * @brief : Command-line options shared by every mode
+ */
+struct dc_options
+{
+    bool warnUninit;
+    bool analyze;             // loop termination and value ranges
+    bool parallelize;         // independent loop statements into par
+    bool closedForm;          // run affine loops in closed form
+    bool run;                 // execute the program after validating it
+    bool pipeline;            // lex on a second thread (dc_parse_pipelined)
+    bool limited;
+    dc_limits limits;
+    unsigned jobs;            // worker threads, 0 = one per CPU
+    dc_ingest_backend ingest; // how batch mode loads files
+    dc_perf *perf;            // --perf-counters, nullptr when off
+    bool allocStats;          // charge heap allocations to phases
+    dc_cache *cache;          // --cache, nullptr when off
+};
+
+/* frontend.cpp */
+exitCode validate(dc_context *ctx, const dc_options &opt, const char *data, size_t len,
+                  std::string *out, std::string *err);
+int cacheLoad(dc_cache *cache, const char *path);
+int cacheSave(dc_cache *cache, const char *path);
+
+/* perf.cpp */
+dc_perf *perfOpen(std::string *why);
+void perfClose(dc_perf *perf);
+void perfBegin(dc_perf *perf);
+void perfEnd(dc_perf *perf, int phase);
+void perfExclude(dc_perf *perf, int phase, int from);
+void perfReport(const dc_perf *perf, size_t bytes, std::string *out);
+
+/* allocstats.cpp */
+bool allocAvailable();
+void allocPass(int which);
+void allocPhase(int phase);
+void allocReport(size_t tokens, std::string *out);
+
+/* native.cpp */
+int emitSource(dc_context *ctx, const char *path, std::string *why);
+int compileNative(dc_context *ctx, const char *exe, std::string *why);
+
+/**
+ * @brief : Files validated together on the workers of dc_ingest
+ */
+struct dc_batch
+{
+    const dc_options *opt;
+    const std::vector<const char *> *files;
+    std::vector<dc_context *> contexts; // one per worker
+    std::vector<exitCode> codes;        // per file
+    std::vector<std::string> outs, errs;
+};
+
+/* batch.cpp */
+std::string prefixed(const char *path, const std::string &text);
+int validateFiles(dc_batch *b);
+int runBatch(const dc_options &opt, const std::vector<const char *> &files);
+
+/* watch.cpp */
+int runWatch(const dc_options &opt, const char *dir);
+
+/* serve.cpp */
+int runServer(const dc_options &opt, const char *path);
+
+#endif
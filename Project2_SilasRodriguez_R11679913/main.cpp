@@ -3,285 +3,143 @@
 Title : main.cpp
 Description : This is a syntax parser + lexical analyzer program.
 Author : silrodri (R#11679913)
-Date : 10/31/2023
-Version : 1.0
+Date : 10/19/2026
+Version : 2.0
 Usage : Compile and run this program using 'make' and ./dcooke_parser [file]
-Notes : This example program has no requirements.
+Notes : Thin front-end over libdcooke (../libdcooke).
 C++ Version : cpp (GCC) 4.8.5 20150623 (Red Hat 4.8.5-16)
 =============================================================================
 */
+#include <algorithm>
 #include <iostream>
-#include <cctype>
-#include <cstring>
-#include <string>
 #include <cstdio>
 #include <cstdlib>
+#include <string>
+#include <vector>
 
-#include "front.h"
-#include "parser.h"
-
-/* Global Variable */
-int nextToken;
-std::string strNextToken;
-char lexeme[100];
-
-/* Local Variables */
-static int charClass;
-static char nextChar;
-static int lexLen;
-static FILE *in_fp;
-static bool handled;
-exitCode exit_code = NoError; // Exit code variable that updates to error out
-
-/* Local Function declarations */
-static void addChar();
-static void getChar();
-static void getNonBlank();
-static void retDirective(int Token);
+#include "frontend.h"
 
 using std::cerr;
 using std::cout;
 using std::endl;
 
-/******************************************************/
-/* lookup - a function to lookup operators and parentheses and return the
- * token */
-static int lookup(char ch)
-{
-    // Handled true by default for "processing the character"
-    handled = true;
-    switch (ch)
-    {
-    case '(':
-        addChar();
-        nextToken = LEFT_PAREN;
-        break;
-    case ')':
-        addChar();
-        nextToken = RIGHT_PAREN;
-        break;
-    case '{':
-        addChar();
-        nextToken = LEFT_CBRACE;
-        break;
-    case '}':
-        addChar();
-        nextToken = RIGHT_CBRACE;
-        break;
-    // could be INC_OP or ADD_OP
-    case '+':
-        addChar(); // push into lexeme
-        getChar(); // check next char
-        if (nextChar == '+')
-        {
-            nextToken = INC_OP;
-            addChar();
-        }
-        else
-        {
-            nextToken = ADD_OP;
-            handled = false; // update that the latest token was not handled yet
-        }
-        break;
-    // could be DEC_OP or ADD_OP
-    case '-':
-        addChar(); // push into lexeme
-        getChar(); // check next char
-        if (nextChar == '-')
-        {
-            nextToken = DEC_OP;
-            addChar();
-        }
-        else
-        {
-            nextToken = SUB_OP;
-            handled = false;
-        }
-        break;
-    case '<':
-    case '>':
-    case '!':
-        addChar(); // push into lexeme
-        getChar(); // check next char
-        if (nextChar == '=')
-        {
-            if (ch == '>')
-                nextToken = GEQUAL_OP;
-            else if (ch == '<')
-                nextToken = LEQUAL_OP;
-            else
-                nextToken = NEQUAL_OP;
-            addChar(); // add into the lexeme
-        }
-        else if (ch == '>')
-        {
-            nextToken = GREATER_OP;
-            handled = false;
-        }
-        else if (ch == '<')
-        {
-            nextToken = LESSER_OP;
-            handled = false;
-        }
-        else
-        {
-            nextToken = UNKNOWN;
-            handled = false;
-        }
-        break;
+static const char *usage =
+    "Usage: ./dcooke_parser [--warn-uninit] [--analyze] [--parallelize] [--closed-form]\n"
+    "       [--run [--exact] | --run-rows=FILE]\n"
+    "       [--hardened] [--max-depth=N] [--max-token-length=N] [--max-tokens=N] [--max-diags=N]\n"
+    "       [--jobs=N] [--ingest=auto|uring|threads] [--pipeline] [--cache[=FILE]] <inputFile>...\n"
+    "       ./dcooke_parser [options] --emit-c=FILE.c | --compile=EXE | --format=FILE <inputFile>\n"
+    "       ./dcooke_parser [options] --profile [--profile-folded=FILE] <inputFile>\n"
+    "       ./dcooke_parser [options] --perf-counters | --alloc-stats <inputFile>\n"
+    "       ./dcooke_parser [options] --serve=<socketPath> | --watch=DIR";
 
-    // could be ASSIGN_OP or EQUAL_OP
-    case '=':
-        addChar(); // push into lexeme
-        getChar(); // check next char
-        if (nextChar == '=')
-        {
-            nextToken = EQUAL_OP;
-            addChar();
-        }
-        // add a bool or back up a file pointer
-        else
-        {
-            nextToken = ASSIGN_OP;
-            handled = false;
-        }
-        break;
-    case '*':
-        addChar();
-        nextToken = MULT_OP;
-        break;
-    case '/':
-        addChar();
-        nextToken = DIV_OP;
-        break;
-    case ';':
-        addChar();
-        nextToken = SEMICOLON;
-        break;
-    default:
-        addChar();
-        if (ch == EOF)
-            nextToken = EOF;
-        else
-            nextToken = UNKNOWN;
-        break;
-    }
-    return nextToken;
+/**
+ * @brief : read() input for --run: whitespace-separated integers on stdin
+ */
+static int readStdin(void *, long long *value)
+{
+    return scanf("%lld", value) == 1 ? 0 : -1;
 }
 
-/*****************************************************/
-/* addChar - a function to add nextChar to lexeme */
-static void addChar()
+/**
+ * @brief : write() output for --run: one value per line on stdout
+ */
+static void writeStdout(void *, long long value)
 {
-    if (lexLen <= 98)
-    {
-        lexeme[lexLen++] = nextChar;
-        lexeme[lexLen] = 0;
-    }
-    else
-        cerr << "Error - lexeme is too long" << endl;
+    printf("%lld\n", value);
 }
 
-/*****************************************************/
-/* getChar - a function to get the next character of input and determine its
- * character class */
-static void getChar()
+/**
+ * @brief : write() output for --run --exact of a value past long long
+ */
+static void writeDigits(void *, const char *digits)
 {
-    if ((nextChar = getc(in_fp)) != EOF)
-    {
-        if (std::isalpha(nextChar))
-            charClass = LETTER;
-        else if (std::isdigit(nextChar))
-            charClass = DIGIT;
-        else
-            charClass = UNKNOWN;
-    }
-    else
-        charClass = EOF;
+    printf("%s\n", digits);
 }
 
-/*****************************************************/
-/* getNonBlank - a function to call getChar until it returns a non-whitespace
- * character */
-static void getNonBlank()
+/**
+ * @brief : write() output of --run-rows, collected per row
+ */
+static void writeRow(void *user, size_t row, long long value)
 {
-    while (std::isspace(nextChar))
-        getChar();
+    (*(std::vector<std::vector<long long> > *)user)[row].push_back(value);
 }
 
-/*****************************************************/
-/* lex - a simple lexical analyzer for arithmetic expressions */
-int lex()
+/**
+ * @brief : --run-rows: run the program once per line of path (the values
+ *  its read() calls take) in SIMD lanes, printing each row's writes
+ */
+static exitCode runRows(dc_context *ctx, const char *path)
 {
-    lexLen = 0;
-    getNonBlank();
+    FILE *rows_fp = fopen(path, "r");
+    std::vector<std::vector<long long> > rows, outs;
+    std::vector<long long> table;
+    std::vector<size_t> counts;
+    size_t columns = 0;
+    char line[4096];
 
-    switch (charClass)
+    if (rows_fp == nullptr)
     {
-    /* Parse identifiers */
-    case LETTER:
-        addChar();
-        getChar();
-        while (charClass == LETTER || charClass == DIGIT)
-        {
-            addChar();
-            getChar();
-        }
-        // read(V)
-        if (strcmp(lexeme, "read") == 0)
-            nextToken = KEY_READ;
-        // write(V)
-        else if (strcmp(lexeme, "write") == 0)
-            nextToken = KEY_WRITE;
-        // while ()
-        else if (strcmp(lexeme, "while") == 0)
-            nextToken = KEY_WHILE;
-        // do ()
-        else if (strcmp(lexeme, "do") == 0)
-            nextToken = KEY_DO;
-        // Identifier
-        else
-            nextToken = IDENT;
-        break;
-
-    /* Parse integer literals */
-    case DIGIT:
-        addChar();
-        getChar();
-        while (charClass == DIGIT)
+        cerr << "EXIT CODE (" << FileNotFound << "): cannot open" << path << endl;
+        return FileNotFound;
+    }
+    while (fgets(line, sizeof line, rows_fp))
+    {
+        std::vector<long long> row;
+        char *p = line, *end;
+        for (long long v = strtoll(p, &end, 10); end != p; v = strtoll(p, &end, 10))
         {
-            addChar();
-            getChar();
+            row.push_back(v);
+            p = end;
         }
-        nextToken = INT_LIT;
-        break;
-
-    /* Parentheses and operators */
-    case UNKNOWN:
-        lookup(nextChar);
-        if (handled)
-            getChar();
-        break;
-
-    /* EOF */
-    case EOF:
-        nextToken = EOF;
-        lexeme[0] = 'E';
-        lexeme[1] = 'O';
-        lexeme[2] = 'F';
-        lexeme[3] = 0;
-        break;
-    } /* End of switch */
+        columns = std::max(columns, row.size());
+        rows.push_back(row);
+    }
+    fclose(rows_fp);
 
-    // if not the end of file, print the lexeme and token, but always return    -
-    if (!strcmp(lexeme, "EOF") == 0)
+    // column-major, so each read() loads consecutive rows
+    table.assign(columns * rows.size(), 0);
+    for (size_t r = 0; r < rows.size(); r++)
+    {
+        counts.push_back(rows[r].size());
+        for (size_t c = 0; c < rows[r].size(); c++)
+            table[c * rows.size() + r] = rows[r][c];
+    }
+    outs.resize(rows.size());
+    exitCode code = dc_run_batch(ctx, table.data(), rows.size(), columns, counts.data(),
+                                 writeRow, &outs, nullptr);
+    for (size_t r = 0; r < outs.size(); r++)
     {
-        retDirective(nextToken); // update strNext Token
-        // const char *c = strNextToken.data(); // convert to char *
-        // printf("%-10s %s\n\r", lexeme, c);
+        for (size_t k = 0; k < outs[r].size(); k++)
+            printf(k ? " %lld" : "%lld", outs[r][k]);
+        putchar('\n');
     }
-    return nextToken;
-} /* End of function lex */
+    return code;
+}
+
+/**
+ * @brief : Parse the N of a --name=N option into *value
+ * @return bool : true when arg is that option
+ */
+static bool sizeOption(const std::string &arg, const char *name, size_t *value)
+{
+    std::string prefix = std::string(name) + "=";
+    if (arg.compare(0, prefix.size(), prefix) != 0)
+        return false;
+    *value = strtoul(arg.c_str() + prefix.size(), nullptr, 10);
+    return true;
+}
+
+/**
+ * @brief : Write the --cache=FILE results back, if there is a file
+ * @return int : code, passed through
+ */
+static int saveCache(dc_cache *cache, const char *path, int code)
+{
+    if (path != nullptr && cacheSave(cache, path) != 0)
+        cerr << "cannot write cache " << path << endl;
+    return code;
+}
 
 /**
  * @brief : Head function for controlling the program execution
@@ -292,132 +150,255 @@ int lex()
  */
 int main(int argc, char **argv)
 {
+    exitCode exit_code = NoError; // Exit code variable that updates to error out
+    dc_stream *in_stream;
+    size_t jobs = 0;
+    std::vector<const char *> inFiles;
+    const char *serveOn = nullptr;
+    const char *watchDir = nullptr;
+    const char *rowsFile = nullptr;
+    const char *emitTo = nullptr;
+    const char *compileTo = nullptr;
+    const char *formatTo = nullptr;
+    const char *foldedTo = nullptr;
+    bool profile = false;
+    bool exact = false;
+    bool cache = false;
+    const char *cacheFile = nullptr;
+    bool perfCounters = false;
+    dc_options opt = dc_options();
+
     // Echo the R # for the grader
     cout << "DCooke Parser :: R11679913" << endl;
-    // check for an input file being passed or too many files
-    if (argc < 2)
+    // split options from the input files
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "--warn-uninit")
+            opt.warnUninit = true;
+        else if (arg == "--analyze")
+            opt.analyze = true;
+        else if (arg == "--parallelize")
+            opt.parallelize = true;
+        else if (arg == "--closed-form")
+            opt.closedForm = true;
+        else if (arg == "--run")
+            opt.run = true;
+        // --exact runs with bignums instead of wrapping
+        else if (arg == "--exact")
+            exact = opt.run = true;
+        else if (arg.compare(0, 11, "--run-rows=") == 0)
+            rowsFile = argv[i] + 11;
+        else if (arg.compare(0, 9, "--emit-c=") == 0)
+            emitTo = argv[i] + 9;
+        else if (arg.compare(0, 10, "--compile=") == 0)
+            compileTo = argv[i] + 10;
+        else if (arg.compare(0, 9, "--format=") == 0)
+            formatTo = argv[i] + 9;
+        // reuse results across files with the same tokens; with a file,
+        // across runs as well
+        else if (arg == "--cache")
+            cache = true;
+        else if (arg.compare(0, 8, "--cache=") == 0)
+        {
+            cacheFile = argv[i] + 8;
+            cache = true;
+        }
+        // --profile runs the program with statement counters on
+        else if (arg == "--profile")
+            profile = opt.run = true;
+        else if (arg.compare(0, 17, "--profile-folded=") == 0)
+        {
+            foldedTo = argv[i] + 17;
+            profile = opt.run = true;
+        }
+        // caps for untrusted input; --hardened picks conservative defaults
+        else if (arg == "--hardened")
+        {
+            opt.limited = true;
+            opt.limits.maxDepth = 256;
+            opt.limits.maxTokenLength = 99;
+            opt.limits.maxTokens = 1 << 20;
+            opt.limits.maxDiags = 64;
+        }
+        else if (sizeOption(arg, "--max-depth", &opt.limits.maxDepth) ||
+                 sizeOption(arg, "--max-token-length", &opt.limits.maxTokenLength) ||
+                 sizeOption(arg, "--max-tokens", &opt.limits.maxTokens) ||
+                 sizeOption(arg, "--max-diags", &opt.limits.maxDiags))
+            opt.limited = true;
+        else if (sizeOption(arg, "--jobs", &jobs))
+            opt.jobs = (unsigned)jobs;
+        else if (arg == "--ingest=auto" || arg == "--ingest=uring" || arg == "--ingest=threads")
+            opt.ingest = arg == "--ingest=uring"     ? DC_INGEST_URING
+                         : arg == "--ingest=threads" ? DC_INGEST_THREADS
+                                                     : DC_INGEST_AUTO;
+        else if (arg == "--pipeline")
+            opt.pipeline = true;
+        else if (arg == "--perf-counters")
+            perfCounters = true;
+        else if (arg == "--alloc-stats")
+            opt.allocStats = true;
+        else if (arg.compare(0, 8, "--serve=") == 0)
+            serveOn = argv[i] + 8;
+        else if (arg.compare(0, 8, "--watch=") == 0)
+            watchDir = argv[i] + 8;
+        else if (arg.compare(0, 2, "--") == 0)
+        {
+            exit_code = MissingFile;
+            cerr << "Error (" << exit_code << "): "
+                 << "unknown option " << arg << endl
+                 << usage << endl;
+            return exit_code;
+        }
+        else
+            inFiles.push_back(argv[i]);
+    }
+    dc_cache results;
+    results.hits = 0;
+    if (cache)
+        opt.cache = &results;
+    if (cacheFile != nullptr && cacheLoad(&results, cacheFile) != 0)
+        cerr << "cannot read cache " << cacheFile << "; starting empty" << endl;
+    // daemon mode: requests come from dcooke_client instead of argv
+    if (serveOn != nullptr)
+        return saveCache(&results, cacheFile, runServer(opt, serveOn));
+    // revalidate a directory as its files change
+    if (watchDir != nullptr)
+        return saveCache(&results, cacheFile, runWatch(opt, watchDir));
+    // check for an input file being passed
+    if (inFiles.empty())
     {
         exit_code = MissingFile;
         cerr << "Error (" << exit_code << "): "
              << "<inputFile> missing" << endl
-             << "Usage: ./dcooke_parser <inputFile>" << endl;
+             << usage << endl;
         return exit_code;
     }
+    // several files: corpus mode
+    if (inFiles.size() > 1)
+        return saveCache(&results, cacheFile, runBatch(opt, inFiles));
+    // running or compiling the program needs the parse itself
+    if (opt.run || rowsFile != nullptr || emitTo != nullptr || compileTo != nullptr)
+        opt.cache = nullptr;
 
-    // Error opening the specified file
-    if ((in_fp = fopen(argv[1], "r")) == nullptr)
+    std::string why;
+    if (perfCounters && (opt.perf = perfOpen(&why)) == nullptr)
+        cerr << "perf counters unavailable: " << why << endl;
+    if (opt.perf)
+        perfBegin(opt.perf);
+    // Error opening the specified file; the counters only see this thread,
+    // so under --perf-counters the file is read here rather than streamed
+    in_stream = opt.perf ? dc_stream_load(inFiles[0]) : dc_stream_open(inFiles[0]);
+    if (in_stream == nullptr)
     {
         exit_code = FileNotFound;
         // Open the file specified as a command-line argument
         cerr << "EXIT CODE (" << exit_code << "): cannot open"
-             << argv[1] << endl;
+             << inFiles[0] << endl;
         return exit_code;
     }
-    else
+    // .gz/.zst input is inflated on the stream's thread while the lexer runs,
+    // or already was when it was loaded above
+    dc_context *ctx = dc_create();
+    dc_set_source(ctx, dc_stream_pull, in_stream);
+    if (opt.perf)
     {
-        getChar();
-        do
-        {
-            lex();
-            statement();
-        } while (nextToken != EOF && exit_code != SyntaxError);
+        while (dc_stream_pull(in_stream, ctx) == 0)
+            ;
+        perfEnd(opt.perf, PERF_IO);
     }
-    fclose(in_fp); // Close the file when done
 
-    if (exit_code == NoError)
-        cout << "Syntax Validated: Exit(" << exit_code << ")"
-             << endl;
-    else
-        cout << "Syntax Not Validated: Exit(" << exit_code << ")"
+    if (opt.allocStats && !allocAvailable())
+    {
+        cerr << "allocation stats unavailable: rebuild with make clean && make ALLOC_STATS=1"
              << endl;
-    return exit_code;
-}
+        opt.allocStats = false;
+    }
 
-/**
- * @brief This function maps all the token identifiers (ints) -> string counterparts of their directives
- *
- * @param Token -> int from lookup, pass in nextToken
- */
-static void retDirective(int Token)
-{
-    switch (Token)
+    // the formatter pulls the whole stream, which validate then rescans
+    if (formatTo != nullptr)
     {
-    case ASSIGN_OP:
-        strNextToken = "ASSIGN_OP";
-        break;
-    case LESSER_OP:
-        strNextToken = "LESSER_OP";
-        break;
-    case GREATER_OP:
-        strNextToken = "GREATER_OP";
-        break;
-    case EQUAL_OP:
-        strNextToken = "EQUAL_OP";
-        break;
-    case NEQUAL_OP:
-        strNextToken = "NEQUAL_OP";
-        break;
-    case LEQUAL_OP:
-        strNextToken = "LEQUAL_OP";
-        break;
-    case GEQUAL_OP:
-        strNextToken = "GEQUAL_OP";
-        break;
-    case SEMICOLON:
-        strNextToken = "SEMICOLON";
-        break;
-
-    case ADD_OP:
-        strNextToken = "ADD_OP";
-        break;
-    case SUB_OP:
-        strNextToken = "SUB_OP";
-        break;
-    case MULT_OP:
-        strNextToken = "MULT_OP";
-        break;
-    case DIV_OP:
-        strNextToken = "DIV_OP";
-        break;
-    case INC_OP:
-        strNextToken = "INC_OP";
-        break;
-    case DEC_OP:
-        strNextToken = "DEC_OP";
-        break;
-    case LEFT_PAREN:
-        strNextToken = "LEFT_PAREN";
-        break;
-    case RIGHT_PAREN:
-        strNextToken = "RIGHT_PAREN";
-        break;
-
-    case LEFT_CBRACE:
-        strNextToken = "LEFT_CBRACE";
-        break;
-    case RIGHT_CBRACE:
-        strNextToken = "RIGHT_CBRACE";
-        break;
-    case KEY_READ:
-        strNextToken = "KEY_READ";
-        break;
-    case KEY_WRITE:
-        strNextToken = "KEY_WRITE";
-        break;
-    case KEY_WHILE:
-        strNextToken = "KEY_WHILE";
-        break;
-    case KEY_DO:
-        strNextToken = "KEY_DO";
-        break;
-    case IDENT:
-        strNextToken = "IDENT";
-        break;
-    case INT_LIT:
-        strNextToken = "INT_LIT";
-        break;
-    default:
-        strNextToken = "UNKNOWN";
-        break;
+        FILE *format_fp = fopen(formatTo, "w");
+        int rc = format_fp == nullptr ? -1 : dc_format(ctx, format_fp);
+        if (format_fp != nullptr && fclose(format_fp) != 0)
+            rc = -1;
+        char hash[32];
+        snprintf(hash, sizeof hash, "%016llx", dc_token_hash(ctx));
+        if (rc != 0)
+            cerr << "cannot write " << formatTo << endl;
+        else
+            cout << "Token hash: " << hash << endl;
+    }
+    std::string out, err;
+    exit_code = validate(ctx, opt, nullptr, 0, &out, &err);
+    size_t bytes = dc_stream_bytes(in_stream);
+    if (dc_stream_error(in_stream) != nullptr)
+    {
+        exit_code = FileNotFound;
+        cerr << "EXIT CODE (" << exit_code << "): cannot read "
+             << inFiles[0] << ": " << dc_stream_error(in_stream) << endl;
+        dc_stream_close(in_stream);
+        dc_destroy(ctx);
+        return exit_code;
+    }
+    dc_stream_close(in_stream);
+    if (opt.cache)
+        saveCache(opt.cache, cacheFile, exit_code);
+    cerr << err;
+    cout << out;
+    // the same work again on warm buffers should not allocate per token
+    if (opt.allocStats)
+    {
+        std::string again, againErr, table;
+        allocPass(ALLOC_STEADY);
+        validate(ctx, opt, nullptr, 0, &again, &againErr);
+        allocReport(dc_token_count(ctx), &table);
+        cerr << table;
+    }
+    // lower a valid program to C, and on to a native executable
+    if (emitTo != nullptr && exit_code == NoError && emitSource(ctx, emitTo, &why) != 0)
+        cerr << "cannot emit " << emitTo << ": " << why << endl;
+    if (compileTo != nullptr && exit_code == NoError && compileNative(ctx, compileTo, &why) != 0)
+        cerr << "cannot compile " << compileTo << ": " << why << endl;
+    // run a valid program, par branches on --jobs workers
+    if (rowsFile != nullptr && exit_code == NoError)
+    {
+        cout.flush();
+        exit_code = runRows(ctx, rowsFile);
+        fflush(stdout);
+        for (size_t i = 0; i < dc_diag_count(ctx); i++)
+            if (dc_diag_kind_at(ctx, i) == DC_DIAG_RUNTIME)
+                cerr << dc_diag_message(ctx, i) << endl;
+    }
+    else if (opt.run && exit_code == NoError)
+    {
+        cout.flush();
+        dc_set_profiling(ctx, profile);
+        dc_set_exact(ctx, exact, writeDigits);
+        exit_code = dc_run(ctx, opt.jobs, readStdin, writeStdout, nullptr);
+        fflush(stdout);
+        for (size_t i = 0; i < dc_diag_count(ctx); i++)
+            if (dc_diag_kind_at(ctx, i) == DC_DIAG_RUNTIME)
+                cerr << dc_diag_message(ctx, i) << endl;
+        // the counts hold up to a runtime error too
+        if (profile && foldedTo == nullptr)
+            dc_profile_report(ctx, stderr);
+        if (foldedTo != nullptr)
+        {
+            FILE *folded_fp = fopen(foldedTo, "w");
+            if (folded_fp == nullptr || dc_profile_folded(ctx, folded_fp) != 0)
+                cerr << "cannot write " << foldedTo << endl;
+            if (folded_fp != nullptr)
+                fclose(folded_fp);
+        }
     }
-}
\ No newline at end of file
+    dc_destroy(ctx);
+    if (opt.perf)
+    {
+        std::string table;
+        perfReport(opt.perf, bytes, &table);
+        perfClose(opt.perf);
+        cerr << table;
+    }
+    return exit_code;
+}
@@ -0,0 +1,120 @@
+/*
+=============================================================================
+Title : native.cpp
+Description : --emit-c and --compile: a validated program as C source or as
+              a native executable.
+Author : silrodri (R#11679913)
+Date : 10/19/2026
+Version : 2.0
+Usage : Linked into dcooke_parser
+Notes : --compile pipes the dc_emit_c() source into the host C++ compiler
+        ($CXX, or g++ when unset) as 'g++ -O2 -x c++ -o OUT -'. The compiler
+        is run directly rather than through the shell, so OUT needs no
+        quoting. SIGPIPE is blocked while the source is written, so a
+        compiler that exits early fails the write instead of killing us.
+C++ Version : cpp (GCC) 4.8.5 20150623 (Red Hat 4.8.5-16)
+=============================================================================
+*/
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <pthread.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "frontend.h"
+
+/**
+ * @brief Write the program as C source to path
+ */
+int emitSource(dc_context *ctx, const char *path, std::string *why)
+{
+    FILE *out_fp = fopen(path, "w");
+    if (out_fp == nullptr)
+    {
+        *why = strerror(errno);
+        return -1;
+    }
+    int rc = dc_emit_c(ctx, out_fp);
+    if (fclose(out_fp) != 0 || rc != 0)
+    {
+        *why = "cannot write the C source";
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Compile the program to the executable exe with the host compiler
+ */
+int compileNative(dc_context *ctx, const char *exe, std::string *why)
+{
+    const char *cxx = getenv("CXX") ? getenv("CXX") : "g++";
+    int fds[2];
+    if (pipe(fds) != 0)
+    {
+        *why = strerror(errno);
+        return -1;
+    }
+
+    pid_t pid = fork();
+    if (pid < 0)
+    {
+        *why = strerror(errno);
+        close(fds[0]);
+        close(fds[1]);
+        return -1;
+    }
+    if (pid == 0)
+    {
+        // child: the source arrives on stdin
+        dup2(fds[0], 0);
+        close(fds[0]);
+        close(fds[1]);
+        execlp(cxx, cxx, "-O2", "-x", "c++", "-o", exe, "-", (char *)nullptr);
+        fprintf(stderr, "cannot run %s: %s\n", cxx, strerror(errno));
+        _exit(127);
+    }
+
+    // a compiler that dies early raises SIGPIPE on this thread; block it
+    // and drop the pending signal afterwards, so the write just fails
+    sigset_t pipe_set, old_set;
+    sigemptyset(&pipe_set);
+    sigaddset(&pipe_set, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &pipe_set, &old_set);
+
+    close(fds[0]);
+    FILE *to_cc = fdopen(fds[1], "w");
+    int rc = to_cc ? dc_emit_c(ctx, to_cc) : -1;
+    if (to_cc)
+    {
+        if (fclose(to_cc) != 0)
+            rc = -1;
+    }
+    else
+        close(fds[1]);
+
+    sigset_t pending;
+    sigpending(&pending);
+    if (sigismember(&pending, SIGPIPE) && !sigismember(&old_set, SIGPIPE))
+    {
+        struct timespec now = {0, 0};
+        while (sigtimedwait(&pipe_set, nullptr, &now) < 0 && errno == EINTR)
+            ;
+    }
+    pthread_sigmask(SIG_SETMASK, &old_set, nullptr);
+
+    int status;
+    while (waitpid(pid, &status, 0) < 0 && errno == EINTR)
+        ;
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+        *why = std::string(cxx) + " failed";
+    else if (rc != 0)
+        *why = "cannot write the C source";
+    else
+        return 0;
+    return -1;
+}
@@ -0,0 +1,192 @@
+/*
+=============================================================================
+Title : perf.cpp
+Description : Hardware performance counters per phase (--perf-counters).
+Author : silrodri (R#11679913)
+Date : 10/19/2026
+Version : 2.0
+Usage : Linked into dcooke_parser; Linux only (perf_event_open)
+Notes : Each counter is opened on its own rather than as a group, so a
+        counter the host or VM does not provide shows as n/a while the
+        others still count. Readings are scaled by time enabled/running
+        in case the kernel multiplexes them.
+C++ Version : cpp (GCC) 4.8.5 20150623 (Red Hat 4.8.5-16)
+=============================================================================
+*/
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "frontend.h"
+
+#define PERF_EVENTS 5
+
+static const char *const eventNames[PERF_EVENTS] = {
+    "cycles", "instructions", "branch-misses", "L1d-misses", "LLC-misses"};
+
+static const char *const phaseNames[PERF_PHASES] = {"io", "lex", "parse"};
+
+struct dc_perf
+{
+    int fd[PERF_EVENTS];
+    unsigned long long start[PERF_EVENTS];
+    unsigned long long total[PERF_PHASES][PERF_EVENTS];
+};
+
+#ifdef __linux__
+/**
+ * @brief Open one counting event on this thread; -1 if unavailable
+ */
+static int openEvent(unsigned type, unsigned long long config)
+{
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof attr);
+    attr.size = sizeof attr;
+    attr.type = type;
+    attr.config = config;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    int fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    // perf_event_paranoid >= 2 only allows user-space counting
+    if (fd < 0 && (errno == EACCES || errno == EPERM))
+    {
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    }
+    return fd;
+}
+
+/**
+ * @brief Current scaled value of one counter
+ */
+static unsigned long long readEvent(int fd)
+{
+    unsigned long long v[3]; // value, time enabled, time running
+    if (read(fd, v, sizeof v) != (ssize_t)sizeof v || v[2] == 0)
+        return 0;
+    if (v[2] < v[1])
+        return (unsigned long long)((double)v[0] * v[1] / v[2]);
+    return v[0];
+}
+#endif
+
+/**
+ * @brief Open the counters; nullptr (with *why set) if none are available
+ */
+dc_perf *perfOpen(std::string *why)
+{
+#ifdef __linux__
+    const unsigned long long l1dMiss = PERF_COUNT_HW_CACHE_L1D |
+                                       (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                       (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    dc_perf *perf = new dc_perf();
+    int opened = 0;
+
+    perf->fd[0] = openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    perf->fd[1] = openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+    perf->fd[2] = openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+    perf->fd[3] = openEvent(PERF_TYPE_HW_CACHE, l1dMiss);
+    perf->fd[4] = openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+    for (int e = 0; e < PERF_EVENTS; e++)
+        opened += perf->fd[e] >= 0;
+    if (opened > 0)
+        return perf;
+    *why = strerror(errno);
+    delete perf;
+#else
+    *why = "perf_event_open needs Linux";
+#endif
+    return nullptr;
+}
+
+void perfClose(dc_perf *perf)
+{
+#ifdef __linux__
+    for (int e = 0; e < PERF_EVENTS; e++)
+        if (perf->fd[e] >= 0)
+            close(perf->fd[e]);
+#endif
+    delete perf;
+}
+
+void perfBegin(dc_perf *perf)
+{
+#ifdef __linux__
+    for (int e = 0; e < PERF_EVENTS; e++)
+        perf->start[e] = perf->fd[e] >= 0 ? readEvent(perf->fd[e]) : 0;
+#endif
+}
+
+/**
+ * @brief Charge the counts since perfBegin to phase
+ */
+void perfEnd(dc_perf *perf, int phase)
+{
+#ifdef __linux__
+    for (int e = 0; e < PERF_EVENTS; e++)
+        if (perf->fd[e] >= 0)
+            perf->total[phase][e] += readEvent(perf->fd[e]) - perf->start[e];
+#endif
+}
+
+/**
+ * @brief Subtract the counts of phase from out of phase, e.g. the lex share
+ *  of a dc_parse() measurement (it lexes on demand)
+ */
+void perfExclude(dc_perf *perf, int phase, int from)
+{
+    for (int e = 0; e < PERF_EVENTS; e++)
+        perf->total[phase][e] -= std::min(perf->total[phase][e], perf->total[from][e]);
+}
+
+static void row(std::string *out, const char *name, const dc_perf *perf,
+                const unsigned long long *v, double scale)
+{
+    char cell[32];
+    snprintf(cell, sizeof cell, "%-10s", name);
+    *out += cell;
+    for (int e = 0; e < PERF_EVENTS; e++)
+    {
+        if (perf->fd[e] < 0)
+            snprintf(cell, sizeof cell, " %14s", "n/a");
+        else
+            snprintf(cell, sizeof cell, " %14.0f", v[e] * scale);
+        *out += cell;
+    }
+    if (perf->fd[0] >= 0 && perf->fd[1] >= 0 && v[0] > 0)
+        snprintf(cell, sizeof cell, " %6.2f\n", (double)v[1] / v[0]);
+    else
+        snprintf(cell, sizeof cell, " %6s\n", "n/a");
+    *out += cell;
+}
+
+/**
+ * @brief Format the per-phase and per-MB table
+ */
+void perfReport(const dc_perf *perf, size_t bytes, std::string *out)
+{
+    char line[160];
+    double mb = bytes / 1e6;
+
+    snprintf(line, sizeof line, "perf counters, %zu bytes of input\n%-10s", bytes, "phase");
+    *out += line;
+    for (int e = 0; e < PERF_EVENTS; e++)
+    {
+        snprintf(line, sizeof line, " %14s", eventNames[e]);
+        *out += line;
+    }
+    *out += "    IPC\n";
+    for (int p = 0; p < PERF_PHASES; p++)
+        row(out, phaseNames[p], perf, perf->total[p], 1);
+    if (bytes == 0)
+        return;
+    for (int p = 0; p < PERF_PHASES; p++)
+        row(out, (std::string(phaseNames[p]) + "/MB").c_str(), perf, perf->total[p], 1 / mb);
+}
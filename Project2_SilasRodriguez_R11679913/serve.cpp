@@ -0,0 +1,439 @@
+/*
+=============================================================================
+Title : serve.cpp
+Description : Server mode of dcooke_parser: a validation daemon on a Unix
+              domain socket.
+Author : silrodri (R#11679913)
+Date : 10/19/2026
+Version : 2.0
+Usage : ./dcooke_parser [options] --serve=<socketPath>, then dcooke_client
+Notes : Protocol (one connection may pipeline any number of requests and
+        gets the responses back in request order):
+          request  : <VALIDATE|TOKENIZE> PATH <len> [warn-uninit]\n<path>
+                     <VALIDATE|TOKENIZE> DATA <len> [warn-uninit]\n<source>
+          response : <exitCode> <outLen> <errLen>\n<out><err>
+        out/err are exactly what dcooke_parser (or, for TOKENIZE,
+        dcooke_analyzer) would print after its banner. A body over
+        MAX_PAYLOAD bytes is skipped and answered with LimitExceeded.
+C++ Version : cpp (GCC) 4.8.5 20150623 (Red Hat 4.8.5-16)
+=============================================================================
+*/
+#include <algorithm>
+#include <condition_variable>
+#include <csignal>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <sstream>
+#include <thread>
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "frontend.h"
+
+using std::cerr;
+using std::endl;
+
+#define MAX_PAYLOAD ((size_t)1 << 28) // largest request body accepted (256 MiB)
+
+/**
+ * @brief : One request and, once done, its response
+ */
+struct dc_request
+{
+    bool tokenize;
+    bool warnUninit;
+    bool byPath;
+    std::string payload; // path or source text
+    exitCode code;
+    std::string out, err;
+    bool done;
+};
+
+typedef std::shared_ptr<dc_request> dc_request_ptr;
+
+/**
+ * @brief : Responses of one connection, kept in request order
+ */
+struct dc_conn
+{
+    int fd;
+    std::mutex lock;
+    std::condition_variable changed;
+    std::deque<dc_request_ptr> pending;
+    bool eof;
+};
+
+/**
+ * @brief : Requests waiting for a warm worker
+ */
+struct dc_jobs
+{
+    std::mutex lock;
+    std::condition_variable ready;
+    std::deque<std::pair<dc_request_ptr, dc_conn *> > queue;
+};
+
+static const char *socketPath;
+
+/**
+ * @brief SIGINT/SIGTERM: remove the socket file and leave
+ */
+static void onSignal(int)
+{
+    unlink(socketPath);
+    _exit(0);
+}
+
+/**
+ * @brief : Buffered reads from a connection, so small pipelined requests do
+ *  not cost a syscall per byte
+ */
+struct dc_reader
+{
+    int fd;
+    size_t at, end;
+    char buf[65536];
+};
+
+/**
+ * @brief Refill the buffer; false on EOF or error
+ */
+static bool fill(dc_reader *r)
+{
+    ssize_t n;
+    do
+        n = read(r->fd, r->buf, sizeof r->buf);
+    while (n < 0 && errno == EINTR);
+    if (n <= 0)
+        return false;
+    r->at = 0;
+    r->end = (size_t)n;
+    return true;
+}
+
+/**
+ * @brief Read exactly len bytes, or skip them when dst is nullptr; false
+ *  on EOF or error
+ */
+static bool readFull(dc_reader *r, char *dst, size_t len)
+{
+    while (len > 0)
+    {
+        if (r->at == r->end && !fill(r))
+            return false;
+        size_t n = std::min(len, r->end - r->at);
+        if (dst != nullptr)
+        {
+            memcpy(dst, r->buf + r->at, n);
+            dst += n;
+        }
+        r->at += n;
+        len -= n;
+    }
+    return true;
+}
+
+/**
+ * @brief Read one header line of at most 256 bytes
+ */
+static bool readLine(dc_reader *r, std::string *line)
+{
+    line->clear();
+    while (line->size() < 256)
+    {
+        if (r->at == r->end && !fill(r))
+            return false;
+        char c = r->buf[r->at++];
+        if (c == '\n')
+            return true;
+        *line += c;
+    }
+    return false;
+}
+
+/**
+ * @brief Write all of buf; false on error
+ */
+static bool writeFull(int fd, const char *buf, size_t len)
+{
+    while (len > 0)
+    {
+        ssize_t n = write(fd, buf, len);
+        if (n <= 0)
+            return false;
+        buf += n;
+        len -= (size_t)n;
+    }
+    return true;
+}
+
+/**
+ * @brief Tokenize a buffer and format it like dcooke_analyzer
+ */
+static exitCode tokenize(dc_context *ctx, const dc_options &opt, const char *data, size_t len,
+                         std::string *out, std::string *err)
+{
+    char line[256];
+
+    dc_reset(ctx);
+    if (opt.limited)
+        dc_set_limits(ctx, &opt.limits);
+    dc_feed(ctx, data, len);
+    exitCode code = dc_tokenize(ctx);
+    for (size_t i = 0; i < dc_diag_count(ctx); i++)
+        *err += std::string(dc_diag_message(ctx, i)) + "\n";
+    for (size_t i = 0; i < dc_token_count(ctx); i++)
+    {
+        snprintf(line, sizeof line, "%-10s %s\n\r", dc_token_lexeme(ctx, i),
+                 dc_token_name(dc_token_code(ctx, i)));
+        *out += line;
+    }
+    return code;
+}
+
+/**
+ * @brief Run one request on a worker's context
+ */
+static void serveOne(dc_context *ctx, dc_options opt, dc_request *req)
+{
+    std::string src;
+
+    if (req->byPath)
+    {
+        FILE *in_fp = fopen(req->payload.c_str(), "r");
+        char buf[BUFSIZ];
+        size_t n;
+        if (in_fp == nullptr)
+        {
+            req->code = FileNotFound;
+            req->err = "EXIT CODE (" + std::to_string(FileNotFound) + "): cannot open" +
+                       req->payload + "\n";
+            return;
+        }
+        while ((n = fread(buf, 1, sizeof buf, in_fp)) > 0)
+            src.append(buf, n);
+        fclose(in_fp);
+    }
+    else
+        src.swap(req->payload);
+
+    opt.warnUninit = opt.warnUninit || req->warnUninit;
+    if (req->tokenize)
+        req->code = tokenize(ctx, opt, src.data(), src.size(), &req->out, &req->err);
+    else
+        req->code = validate(ctx, opt, src.data(), src.size(), &req->out, &req->err);
+}
+
+/**
+ * @brief Warm worker: owns one context for its whole life
+ */
+static void worker(dc_jobs *jobs, const dc_options *opt)
+{
+    dc_context *ctx = dc_create();
+    for (;;)
+    {
+        std::pair<dc_request_ptr, dc_conn *> job;
+        {
+            std::unique_lock<std::mutex> hold(jobs->lock);
+            while (jobs->queue.empty())
+                jobs->ready.wait(hold);
+            job = jobs->queue.front();
+            jobs->queue.pop_front();
+        }
+        try
+        {
+            serveOne(ctx, *opt, job.first.get());
+        }
+        catch (const std::bad_alloc &)
+        {
+            // a huge file by PATH: fail this request, not the daemon
+            job.first->code = LimitExceeded;
+            job.first->out.clear();
+            job.first->err = "Error - out of memory\n";
+        }
+        {
+            std::lock_guard<std::mutex> hold(job.second->lock);
+            job.first->done = true;
+        }
+        job.second->changed.notify_all();
+    }
+}
+
+/**
+ * @brief Connection writer: send responses in request order as they finish.
+ *  After a failed write it keeps draining, so no worker is left holding a
+ *  request of a connection that has gone away.
+ */
+static void writer(dc_conn *conn)
+{
+    bool broken = false;
+    for (;;)
+    {
+        dc_request_ptr req;
+        {
+            std::unique_lock<std::mutex> hold(conn->lock);
+            while (!(conn->pending.empty() ? conn->eof : conn->pending.front()->done))
+                conn->changed.wait(hold);
+            if (conn->pending.empty())
+                return;
+            req = conn->pending.front();
+            conn->pending.pop_front();
+        }
+        if (broken)
+            continue;
+        std::ostringstream head;
+        head << req->code << " " << req->out.size() << " " << req->err.size() << "\n";
+        std::string msg = head.str() + req->out + req->err;
+        broken = !writeFull(conn->fd, msg.data(), msg.size());
+    }
+}
+
+/**
+ * @brief Connection reader: parse pipelined requests and queue them
+ */
+static void connection(int fd, dc_jobs *jobs)
+{
+    dc_conn conn;
+    conn.fd = fd;
+    conn.eof = false;
+    std::thread out(writer, &conn);
+
+    std::unique_ptr<dc_reader> in(new dc_reader());
+    in->fd = fd;
+    in->at = in->end = 0;
+    std::string line;
+    // out of memory ends this connection only
+    try
+    {
+        while (readLine(in.get(), &line))
+        {
+            char verb[16], how[8], flag[16] = "";
+            unsigned long len;
+            if (sscanf(line.c_str(), "%15s %7s %lu %15s", verb, how, &len, flag) < 3)
+                break;
+
+            dc_request_ptr req(new dc_request());
+            req->tokenize = strcmp(verb, "TOKENIZE") == 0;
+            req->byPath = strcmp(how, "PATH") == 0;
+            req->warnUninit = strcmp(flag, "warn-uninit") == 0;
+            bool fits = len <= MAX_PAYLOAD;
+            if (fits)
+            {
+                try
+                {
+                    req->payload.resize(len);
+                }
+                catch (const std::bad_alloc &)
+                {
+                    fits = false;
+                }
+            }
+            // too big: skip the body and answer in its place in the order
+            if (!fits)
+            {
+                req->code = LimitExceeded;
+                req->err = "Error - request of " + std::to_string(len) +
+                           " bytes is over the limit of " + std::to_string(MAX_PAYLOAD) +
+                           " bytes\n";
+                {
+                    std::lock_guard<std::mutex> hold(conn.lock);
+                    req->done = true;
+                    conn.pending.push_back(req);
+                }
+                conn.changed.notify_all();
+                if (!readFull(in.get(), nullptr, len))
+                    break;
+                continue;
+            }
+            if (len > 0 && !readFull(in.get(), &req->payload[0], len))
+                break;
+            {
+                std::lock_guard<std::mutex> hold(conn.lock);
+                conn.pending.push_back(req);
+            }
+            {
+                std::lock_guard<std::mutex> hold(jobs->lock);
+                jobs->queue.push_back(std::make_pair(req, &conn));
+            }
+            jobs->ready.notify_one();
+        }
+    }
+    catch (const std::bad_alloc &)
+    {
+        cerr << "Error - out of memory on a connection; closing it" << endl;
+    }
+    {
+        std::lock_guard<std::mutex> hold(conn.lock);
+        conn.eof = true;
+    }
+    conn.changed.notify_all();
+    out.join();
+    close(fd);
+}
+
+/**
+ * @brief Listen on path and serve requests until SIGINT/SIGTERM
+ */
+int runServer(const dc_options &opt, const char *path)
+{
+    sockaddr_un addr;
+    unsigned workers = opt.jobs ? opt.jobs : std::max(1u, std::thread::hardware_concurrency());
+    static dc_jobs jobs;
+
+    memset(&addr, 0, sizeof addr);
+    addr.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof addr.sun_path)
+    {
+        cerr << "Error - socket path too long: " << path << endl;
+        return MissingFile;
+    }
+    strcpy(addr.sun_path, path);
+
+    // replace a stale socket from an earlier run, but nothing else
+    struct stat st;
+    if (lstat(path, &st) == 0)
+    {
+        if (!S_ISSOCK(st.st_mode))
+        {
+            cerr << "Error - " << path << " exists and is not a socket" << endl;
+            return FileNotFound;
+        }
+        unlink(path);
+    }
+    int lfd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (lfd < 0 || bind(lfd, (sockaddr *)&addr, sizeof addr) < 0 || listen(lfd, 128) < 0)
+    {
+        cerr << "Error - cannot listen on " << path << ": " << strerror(errno) << endl;
+        return FileNotFound;
+    }
+    socketPath = path;
+    signal(SIGINT, onSignal);
+    signal(SIGTERM, onSignal);
+    signal(SIGPIPE, SIG_IGN);
+
+    for (unsigned w = 0; w < workers; w++)
+        std::thread(worker, &jobs, &opt).detach();
+    cerr << "Serving on " << path << " with " << workers << " workers" << endl;
+
+    for (;;)
+    {
+        int fd = accept(lfd, nullptr, nullptr);
+        if (fd < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            cerr << "Error - accept: " << strerror(errno) << endl;
+            return FileNotFound;
+        }
+        std::thread(connection, fd, &jobs).detach();
+    }
+}
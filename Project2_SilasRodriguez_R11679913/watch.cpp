@@ -0,0 +1,304 @@
+/*
+=============================================================================
+Title : watch.cpp
+Description : Watch mode of dcooke_parser: revalidate .dc files as they
+              change.
+Author : silrodri (R#11679913)
+Date : 10/19/2026
+Version : 2.0
+Usage : ./dcooke_parser [options] --watch=DIR (Ctrl-C to stop)
+Notes : Every .dc file under DIR is validated once, then inotify reports
+        what changes. Events are collected until SETTLE_MS pass without
+        one, so an editor's save (or a git checkout) is one round, and
+        only the files named in that round are loaded and validated, on
+        the same workers as corpus mode. The pass/fail state of every file
+        is kept in memory, so the summary after a round costs no more than
+        the round itself.
+C++ Version : cpp (GCC) 4.8.5 20150623 (Red Hat 4.8.5-16)
+=============================================================================
+*/
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <set>
+#include <thread>
+
+#include <dirent.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "frontend.h"
+
+using std::cerr;
+using std::cout;
+using std::endl;
+
+#define SETTLE_MS 50 // quiet time that ends a round of events
+
+#define WATCH_MASK                                                                        \
+    (IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE | IN_CREATE | IN_ONLYDIR)
+
+/**
+ * @brief : Watch state
+ */
+struct dc_watch
+{
+    int fd; // inotify
+    std::string root;
+    std::map<int, std::string> dirs;       // watch descriptor -> directory
+    std::map<std::string, exitCode> files; // last result of every .dc file
+    size_t passed;                         // files[] entries that are NoError
+    std::set<std::string> changed, removed; // the round being collected
+    dc_batch batch;
+};
+
+static bool isSource(const char *name)
+{
+    size_t len = strlen(name);
+    return len > 3 && strcmp(name + len - 3, ".dc") == 0;
+}
+
+/**
+ * @brief Watch dir and every directory below it; the .dc files found are
+ *  queued for validation
+ */
+static void addTree(dc_watch *w, const std::string &dir)
+{
+    int wd = inotify_add_watch(w->fd, dir.c_str(), WATCH_MASK);
+    if (wd < 0)
+    {
+        cerr << "watch: cannot watch " << dir << " (" << strerror(errno) << ")" << endl;
+        return;
+    }
+    w->dirs[wd] = dir;
+
+    DIR *d = opendir(dir.c_str());
+    if (d == nullptr)
+        return;
+    while (struct dirent *e = readdir(d))
+    {
+        if (strcmp(e->d_name, ".") == 0 || strcmp(e->d_name, "..") == 0)
+            continue;
+        std::string path = dir + "/" + e->d_name;
+        struct stat st;
+        if (stat(path.c_str(), &st) != 0)
+            continue;
+        if (S_ISDIR(st.st_mode))
+            addTree(w, path);
+        else if (S_ISREG(st.st_mode) && isSource(e->d_name))
+        {
+            w->removed.erase(path);
+            w->changed.insert(path);
+        }
+    }
+    closedir(d);
+}
+
+/**
+ * @brief Forget a file, or with tree every file below a directory
+ */
+static void forget(dc_watch *w, const std::string &path, bool tree)
+{
+    if (!tree)
+    {
+        w->changed.erase(path);
+        w->removed.insert(path);
+        return;
+    }
+    std::string prefix = path + "/";
+    std::map<std::string, exitCode>::iterator it = w->files.lower_bound(prefix);
+    for (; it != w->files.end() && it->first.compare(0, prefix.size(), prefix) == 0; ++it)
+        w->removed.insert(it->first);
+    std::set<std::string>::iterator c = w->changed.lower_bound(prefix);
+    while (c != w->changed.end() && c->compare(0, prefix.size(), prefix) == 0)
+        w->changed.erase(c++);
+}
+
+/**
+ * @brief Read the events inotify has ready into the round
+ * @return bool : false when the inotify descriptor failed
+ */
+static bool drain(dc_watch *w)
+{
+    char buf[64 * 1024] __attribute__((aligned(__alignof__(struct inotify_event))));
+    ssize_t n = read(w->fd, buf, sizeof buf);
+    if (n < 0)
+        return errno == EINTR || errno == EAGAIN;
+
+    for (char *p = buf; p < buf + n;)
+    {
+        const struct inotify_event *ev = (const struct inotify_event *)p;
+        p += sizeof(struct inotify_event) + ev->len;
+
+        if (ev->mask & IN_Q_OVERFLOW)
+        {
+            // events were lost: look at everything again
+            std::map<int, std::string>::iterator d = w->dirs.begin();
+            for (; d != w->dirs.end(); ++d)
+                inotify_rm_watch(w->fd, d->first);
+            w->dirs.clear();
+            forget(w, w->root, true);
+            addTree(w, w->root);
+            continue;
+        }
+        if (ev->mask & IN_IGNORED)
+        {
+            w->dirs.erase(ev->wd);
+            continue;
+        }
+        std::map<int, std::string>::iterator d = w->dirs.find(ev->wd);
+        if (d == w->dirs.end() || ev->len == 0)
+            continue;
+        std::string path = d->second + "/" + ev->name;
+
+        if (ev->mask & IN_ISDIR)
+        {
+            if (ev->mask & (IN_CREATE | IN_MOVED_TO))
+                addTree(w, path);
+            else if (ev->mask & (IN_DELETE | IN_MOVED_FROM))
+                forget(w, path, true);
+        }
+        else if (isSource(ev->name))
+        {
+            // a file being created is validated once it is closed
+            if (ev->mask & (IN_CLOSE_WRITE | IN_MOVED_TO))
+            {
+                w->removed.erase(path);
+                w->changed.insert(path);
+            }
+            else if (ev->mask & (IN_DELETE | IN_MOVED_FROM))
+                forget(w, path, false);
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Record a file's new result in the summary
+ */
+static void settle(dc_watch *w, const std::string &path, exitCode code)
+{
+    std::map<std::string, exitCode>::iterator it = w->files.find(path);
+    if (it != w->files.end() && it->second == NoError)
+        w->passed--;
+    if (code == NoError)
+        w->passed++;
+    w->files[path] = code;
+}
+
+/**
+ * @brief Validate the files of the round, print what they said and the
+ *  summary line
+ */
+static void revalidate(dc_watch *w, bool first)
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::vector<std::string> paths(w->changed.begin(), w->changed.end());
+    std::vector<const char *> names;
+    size_t removed = 0;
+    for (size_t i = 0; i < paths.size(); i++)
+        names.push_back(paths[i].c_str());
+    w->batch.files = &names;
+    if (validateFiles(&w->batch) < 0)
+        cerr << "Error - io_uring is not available on this system" << endl;
+
+    for (size_t i = 0; i < paths.size(); i++)
+    {
+        struct stat st;
+        // gone again before it could be read
+        if (w->batch.codes[i] == FileNotFound && stat(names[i], &st) != 0)
+        {
+            w->removed.insert(paths[i]);
+            continue;
+        }
+        settle(w, paths[i], w->batch.codes[i]);
+        cerr << w->batch.errs[i];
+        cout << w->batch.outs[i];
+    }
+    for (std::set<std::string>::iterator r = w->removed.begin(); r != w->removed.end(); ++r)
+    {
+        std::map<std::string, exitCode>::iterator it = w->files.find(*r);
+        if (it == w->files.end())
+            continue;
+        if (it->second == NoError)
+            w->passed--;
+        w->files.erase(it);
+        cout << *r << ": removed" << endl;
+        removed++;
+    }
+
+    long long ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+    cout << "watch: ";
+    if (!first)
+        cout << paths.size() << " changed, " << removed << " removed; ";
+    cout << w->passed << " of " << w->files.size() << " files validated (" << ms << " ms";
+    if (w->batch.opt->cache)
+        cout << ", " << w->batch.opt->cache->hits << " from the cache";
+    cout << ")" << endl;
+    w->changed.clear();
+    w->removed.clear();
+}
+
+/**
+ * @brief Validate every .dc file under dir, then again whatever changes,
+ *  until interrupted
+ */
+int runWatch(const dc_options &opt, const char *dir)
+{
+    dc_watch w;
+    struct stat st;
+    std::string &root = w.root;
+    root = dir;
+    while (root.size() > 1 && root[root.size() - 1] == '/')
+        root.erase(root.size() - 1);
+    if (stat(root.c_str(), &st) != 0 || !S_ISDIR(st.st_mode))
+    {
+        cerr << "EXIT CODE (" << FileNotFound << "): cannot watch " << dir << endl;
+        return FileNotFound;
+    }
+    if ((w.fd = inotify_init1(IN_CLOEXEC)) < 0)
+    {
+        cerr << "Error - inotify: " << strerror(errno) << endl;
+        return FileNotFound;
+    }
+
+    unsigned workers = opt.jobs ? opt.jobs : std::max(1u, std::thread::hardware_concurrency());
+    w.passed = 0;
+    w.batch.opt = &opt;
+    for (unsigned i = 0; i < workers; i++)
+        w.batch.contexts.push_back(dc_create());
+
+    addTree(&w, root);
+    revalidate(&w, true);
+    for (;;)
+    {
+        struct pollfd pfd = {w.fd, POLLIN, 0};
+        // block for the first event, then take more until a quiet spell
+        if (poll(&pfd, 1, -1) < 0 && errno != EINTR)
+            break;
+        if (!drain(&w))
+            break;
+        while (poll(&pfd, 1, SETTLE_MS) > 0)
+            if (!drain(&w))
+                break;
+        if (!w.changed.empty() || !w.removed.empty())
+            revalidate(&w, false);
+        if (w.dirs.empty())
+        {
+            cerr << "watch: " << root << " is gone" << endl;
+            break;
+        }
+    }
+
+    for (size_t i = 0; i < w.batch.contexts.size(); i++)
+        dc_destroy(w.batch.contexts[i]);
+    close(w.fd);
+    return w.passed == w.files.size() ? NoError : SyntaxError;
+}
@@ -0,0 +1,1216 @@
+/*
+=============================================================================
+Title : absint.cpp
+Description : Abstract interpretation of loop termination and value ranges
+              (dc_analyze).
+Author : silrodri (R#11679913)
+Date : 10/19/2026
+Version : 2.0
+Usage : Built into libdcooke; run after a successful dc_parse()
+Notes : Every variable is tracked as an interval reduced with a congruence
+        (x = r mod m), walking the AST in program order. A do-while is
+        iterated from its entry state, widening the intervals after a
+        couple of rounds and giving up on congruences that keep changing,
+        then narrowed once and walked a last time to record its facts.
+        The condition refines the state on both edges: a loop whose exit
+        edge stays empty never terminates. A loop is proven finite when
+        its condition is false on every test, or when it compares a
+        counter that moves the same way by at least one per iteration
+        against a bound the loop never assigns, without wrapping. Loop
+        rounds only copy the variables the loop assigns or tests. The total
+        work is capped, so deep nests or huge variable counts cannot blow
+        up the validation path; past the cap only a note is reported.
+C++ Version : cpp (GCC) 4.8.5 20150623 (Red Hat 4.8.5-16)
+=============================================================================
+*/
+#include <algorithm>
+#include <climits>
+
+#include "cfg.h"
+#include "context.h"
+
+#define WIDEN_AFTER 2 // rounds at a loop head before intervals widen
+#define CONG_ROUNDS 6 // rounds before changing congruences are dropped
+#define WORK_CAP (1 << 20) // work units allowed on top of BUDGET per statement
+#define BUDGET 16
+#define MAX_MOD (1LL << 62)
+
+typedef __int128 wide;
+
+static const wide INF = (wide)1 << 100; // unbounded, in loop deltas
+
+/**
+ * @brief : Abstract value: lo <= x <= hi and x = rem (mod mod). mod 0
+ *  means x is exactly rem; mod 1 means no congruence is known
+ */
+struct dc_aval
+{
+    long long lo, hi;
+    long long mod;
+    long long rem;
+};
+
+/**
+ * @brief : Abstract state; live is false where no run can get to
+ */
+struct dc_astate
+{
+    bool live;
+    std::vector<dc_aval> vars;
+};
+
+/**
+ * @brief : What the recording walk saw of one do-while
+ */
+struct dc_loopfact
+{
+    bool reached; // some run enters the loop
+    bool tested;  // some run gets to the condition
+    bool exits;   // some run leaves through the condition
+    bool repeats; // some run takes the back edge
+};
+
+struct dc_absint
+{
+    const dc_ast *ast;
+    std::vector<dc_aval> held;     // every value each variable can hold
+    std::vector<char> assigned;    // ... once any assignment has run
+    std::vector<dc_loopfact> loops; // per statement
+    std::vector<size_t> sizes;      // statements in each statement's subtree
+    bool record;                    // the walk whose facts count
+    size_t visits, budget;          // work units: 1 per statement visited,
+                                    // scanned or copied variable
+    mutable dc_astate scratch;      // anywhere() sets only what it reads
+    mutable std::vector<std::pair<int, bool> > work; // eval(): (node, operands done)
+    mutable std::vector<dc_aval> values;             // eval(): operand values
+};
+
+static void execList(dc_absint *an, int s, dc_astate *st);
+static void execStmt(dc_absint *an, int s, dc_astate *st);
+static int postfixNet(const dc_ast *ast, int e, int sym);
+
+/******************************************************/
+/* Values */
+
+static dc_aval top()
+{
+    dc_aval v = {LLONG_MIN, LLONG_MAX, 1, 0};
+    return v;
+}
+
+static dc_aval constant(long long c)
+{
+    dc_aval v = {c, c, 0, c};
+    return v;
+}
+
+static wide absw(wide x)
+{
+    return x < 0 ? -x : x;
+}
+
+static wide gcdw(wide a, wide b)
+{
+    a = absw(a);
+    b = absw(b);
+    while (b != 0)
+    {
+        wide t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+/**
+ * @brief Tighten the interval to the congruence and back; false when no
+ *  value is left
+ */
+static bool normalize(dc_aval *v)
+{
+    if (v->lo > v->hi)
+        return false;
+    if (v->mod == 0)
+    {
+        if (v->rem < v->lo || v->rem > v->hi)
+            return false;
+        v->lo = v->hi = v->rem;
+        return true;
+    }
+    if (v->mod > 1)
+    {
+        wide m = v->mod, lo = v->lo, hi = v->hi;
+        lo += ((v->rem - lo) % m + m) % m;
+        hi -= ((hi - v->rem) % m + m) % m;
+        if (lo > hi)
+            return false;
+        v->lo = (long long)lo;
+        v->hi = (long long)hi;
+    }
+    if (v->lo == v->hi)
+    {
+        v->mod = 0;
+        v->rem = v->lo;
+    }
+    return true;
+}
+
+/**
+ * @brief Set the congruence from a modulus and residue in full precision.
+ *  Any divisor of m is still a valid modulus, so large ones are cut back
+ *  to their part in common with 2^62
+ */
+static void setCong(dc_aval *v, wide m, wide r)
+{
+    m = absw(m);
+    if (m == 0)
+    {
+        v->mod = 0;
+        v->rem = (long long)r;
+        return;
+    }
+    if (m > MAX_MOD)
+        m = gcdw(m, MAX_MOD);
+    v->mod = (long long)m;
+    v->rem = (long long)((r % m + m) % m);
+}
+
+static bool contains(const dc_aval &v, long long c)
+{
+    if (c < v.lo || c > v.hi)
+        return false;
+    if (v.mod == 0)
+        return c == v.rem;
+    return (((wide)c - v.rem) % v.mod) == 0;
+}
+
+static dc_aval join(const dc_aval &a, const dc_aval &b)
+{
+    dc_aval v;
+    v.lo = std::min(a.lo, b.lo);
+    v.hi = std::max(a.hi, b.hi);
+    setCong(&v, gcdw(gcdw(a.mod, b.mod), (wide)a.rem - b.rem), a.rem);
+    normalize(&v);
+    return v;
+}
+
+/**
+ * @brief Is every value of a also a value of b
+ */
+static bool within(const dc_aval &a, const dc_aval &b)
+{
+    if (a.lo < b.lo || a.hi > b.hi)
+        return false;
+    if (b.mod == 1)
+        return true;
+    if (b.mod == 0)
+        return a.mod == 0 && a.rem == b.rem;
+    return a.mod % b.mod == 0 && ((wide)a.rem - b.rem) % b.mod == 0;
+}
+
+/**
+ * @brief +, - and * in wrap-around arithmetic
+ */
+static dc_aval arith(int op, const dc_aval &a, const dc_aval &b)
+{
+    dc_aval v;
+    if (a.mod == 0 && b.mod == 0)
+    {
+        unsigned long long x = a.rem, y = b.rem;
+        return constant((long long)(op == ADD_OP ? x + y : op == SUB_OP ? x - y : x * y));
+    }
+
+    wide lo, hi, m, r;
+    if (op == MULT_OP)
+    {
+        wide c[4] = {(wide)a.lo * b.lo, (wide)a.lo * b.hi, (wide)a.hi * b.lo, (wide)a.hi * b.hi};
+        lo = *std::min_element(c, c + 4);
+        hi = *std::max_element(c, c + 4);
+        m = gcdw(gcdw((wide)a.mod * b.mod, (wide)a.mod * b.rem), (wide)b.mod * a.rem);
+        r = (wide)a.rem * b.rem;
+    }
+    else
+    {
+        lo = op == ADD_OP ? (wide)a.lo + b.lo : (wide)a.lo - b.hi;
+        hi = op == ADD_OP ? (wide)a.hi + b.hi : (wide)a.hi - b.lo;
+        m = gcdw(a.mod, b.mod);
+        r = op == ADD_OP ? (wide)a.rem + b.rem : (wide)a.rem - b.rem;
+    }
+    if (lo < LLONG_MIN || hi > LLONG_MAX)
+    {
+        // a wrap keeps only the power-of-two part of the congruence
+        v = top();
+        setCong(&v, gcdw(m, MAX_MOD), r);
+    }
+    else
+    {
+        v.lo = (long long)lo;
+        v.hi = (long long)hi;
+        setCong(&v, m, r);
+    }
+    normalize(&v);
+    return v;
+}
+
+/**
+ * @brief Truncating division by the non-zero part of b; live is cleared
+ *  when b can only be zero
+ */
+static dc_aval divide(const dc_aval &a, const dc_aval &b, bool *live)
+{
+    if (b.mod == 0 && b.rem == 0)
+    {
+        *live = false;
+        return top();
+    }
+    if (a.mod == 0 && b.mod == 0)
+        return constant(b.rem == -1 ? (long long)(0ULL - (unsigned long long)a.rem) : a.rem / b.rem);
+
+    wide lo = INF, hi = -INF;
+    long long parts[2][2] = {{b.lo, std::min(b.hi, -1LL)}, {std::max(b.lo, 1LL), b.hi}};
+    for (int p = 0; p < 2; p++)
+    {
+        if (parts[p][0] > parts[p][1])
+            continue;
+        // monotone in each operand while the divisor keeps its sign
+        for (int i = 0; i < 2; i++)
+            for (int j = 0; j < 2; j++)
+            {
+                wide q = (wide)(i ? a.hi : a.lo) / parts[p][j];
+                lo = std::min(lo, q);
+                hi = std::max(hi, q);
+            }
+    }
+    if (hi > LLONG_MAX) // LLONG_MIN / -1 wraps
+        return top();
+    dc_aval v = {(long long)lo, (long long)hi, 1, 0};
+    normalize(&v);
+    return v;
+}
+
+static dc_aval compare(int op, const dc_aval &a, const dc_aval &b)
+{
+    int yes = -1; // -1: either way
+    switch (op)
+    {
+    case LESSER_OP:
+        yes = a.hi < b.lo ? 1 : a.lo >= b.hi ? 0 : -1;
+        break;
+    case GREATER_OP:
+        yes = a.lo > b.hi ? 1 : a.hi <= b.lo ? 0 : -1;
+        break;
+    case LEQUAL_OP:
+        yes = a.hi <= b.lo ? 1 : a.lo > b.hi ? 0 : -1;
+        break;
+    case GEQUAL_OP:
+        yes = a.lo >= b.hi ? 1 : a.hi < b.lo ? 0 : -1;
+        break;
+    case EQUAL_OP:
+    default:
+        if (a.mod == 0 && b.mod == 0 && a.rem == b.rem)
+            yes = 1;
+        else if (a.hi < b.lo || b.hi < a.lo)
+            yes = 0;
+        if (op != EQUAL_OP && yes >= 0)
+            yes = !yes;
+        break;
+    }
+    if (yes >= 0)
+        return constant(yes);
+    dc_aval v = {0, 1, 1, 0};
+    return v;
+}
+
+/******************************************************/
+/* States */
+
+static void kill(dc_astate *st)
+{
+    st->live = false;
+}
+
+static void joinInto(dc_astate *into, const dc_astate &from)
+{
+    if (!from.live)
+        return;
+    if (!into->live)
+    {
+        *into = from;
+        return;
+    }
+    for (size_t v = 0; v < into->vars.size(); v++)
+        into->vars[v] = join(into->vars[v], from.vars[v]);
+}
+
+static bool stateWithin(const dc_astate &a, const dc_astate &b)
+{
+    if (!a.live)
+        return true;
+    if (!b.live)
+        return false;
+    for (size_t v = 0; v < a.vars.size(); v++)
+        if (!within(a.vars[v], b.vars[v]))
+            return false;
+    return true;
+}
+
+/**
+ * @brief Widen old towards next: a bound that moved jumps to the loop
+ *  guard's bound for that variable while there is one (so 'i < n' stops
+ *  at n - 1 instead of wrapping), else to the end of the range. Late
+ *  rounds drop guards and congruences that still change
+ */
+static void widen(const dc_astate &old, dc_astate *next, int round,
+                  const std::vector<dc_aval> &guards)
+{
+    if (!old.live || !next->live || round < WIDEN_AFTER)
+        return;
+    bool guarded = round < CONG_ROUNDS;
+    for (size_t v = 0; v < next->vars.size(); v++)
+    {
+        const dc_aval &o = old.vars[v];
+        const dc_aval &g = guards[v];
+        dc_aval &n = next->vars[v];
+        if (round >= CONG_ROUNDS && (n.mod != o.mod || n.rem != o.rem))
+            n.mod = 1, n.rem = 0;
+        if (n.lo < o.lo)
+            n.lo = guarded && g.lo <= n.lo ? g.lo : LLONG_MIN;
+        if (n.hi > o.hi)
+            n.hi = guarded && g.hi >= n.hi ? g.hi : LLONG_MAX;
+        normalize(&n);
+    }
+}
+
+static void record(dc_absint *an, int sym, const dc_aval &v)
+{
+    if (!an->record)
+        return;
+    an->held[sym] = an->assigned[sym] ? join(an->held[sym], v) : v;
+    an->assigned[sym] = 1;
+}
+
+/******************************************************/
+/* Expressions */
+
+static bool isVar(const dc_expr &ex)
+{
+    return ex.op == IDENT || ex.op == INC_OP || ex.op == DEC_OP;
+}
+
+static void exclude(dc_astate *st, int sym, long long c)
+{
+    dc_aval &v = st->vars[sym];
+    if (v.lo == c && v.hi == c)
+    {
+        kill(st);
+        return;
+    }
+    if (v.lo == c)
+        v.lo++;
+    else if (v.hi == c)
+        v.hi--;
+    if (!normalize(&v))
+        kill(st);
+}
+
+/**
+ * @brief Evaluate e in st, operands left first, collecting postfix
+ *  operators. A divisor that is a variable is non-zero past the division,
+ *  so st is refined
+ */
+static dc_aval eval(const dc_absint *an, int e, dc_astate *st, std::vector<int> *postfix)
+{
+    const dc_ast *ast = an->ast;
+    std::vector<std::pair<int, bool> > &work = an->work;
+    std::vector<dc_aval> &values = an->values;
+    work.assign(1, std::make_pair(e, false));
+    values.clear();
+    while (!work.empty())
+    {
+        std::pair<int, bool> top = work.back();
+        work.pop_back();
+        const dc_expr &ex = ast->exprs[top.first];
+        switch (ex.op)
+        {
+        case INT_LIT:
+            values.push_back(constant(ex.value));
+            continue;
+        case IDENT:
+            values.push_back(st->vars[ex.symbol]);
+            continue;
+        case INC_OP:
+        case DEC_OP:
+            postfix->push_back(top.first);
+            values.push_back(st->vars[ex.symbol]);
+            continue;
+        }
+        if (!top.second)
+        {
+            work.push_back(std::make_pair(top.first, true));
+            work.push_back(std::make_pair(ex.right, false));
+            work.push_back(std::make_pair(ex.left, false));
+            continue;
+        }
+
+        dc_aval b = values.back();
+        values.pop_back();
+        dc_aval &a = values.back();
+        switch (ex.op)
+        {
+        case ADD_OP:
+        case SUB_OP:
+        case MULT_OP:
+            a = arith(ex.op, a, b);
+            break;
+        case DIV_OP:
+            a = divide(a, b, &st->live);
+            if (st->live && isVar(ast->exprs[ex.right]))
+                exclude(st, ast->exprs[ex.right].symbol, 0);
+            break;
+        default:
+            a = compare(ex.op, a, b);
+            break;
+        }
+    }
+    return values.back();
+}
+
+static void applyPostfix(dc_absint *an, const std::vector<int> &postfix, dc_astate *st)
+{
+    for (size_t i = 0; i < postfix.size(); i++)
+    {
+        const dc_expr &ex = an->ast->exprs[postfix[i]];
+        dc_aval &v = st->vars[ex.symbol];
+        v = arith(ADD_OP, v, constant(ex.op == INC_OP ? 1 : -1));
+        record(an, ex.symbol, v);
+    }
+}
+
+static int negate(int op)
+{
+    switch (op)
+    {
+    case LESSER_OP:
+        return GEQUAL_OP;
+    case GREATER_OP:
+        return LEQUAL_OP;
+    case LEQUAL_OP:
+        return GREATER_OP;
+    case GEQUAL_OP:
+        return LESSER_OP;
+    case EQUAL_OP:
+        return NEQUAL_OP;
+    }
+    return EQUAL_OP;
+}
+
+static int mirror(int op)
+{
+    switch (op)
+    {
+    case LESSER_OP:
+        return GREATER_OP;
+    case GREATER_OP:
+        return LESSER_OP;
+    case LEQUAL_OP:
+        return GEQUAL_OP;
+    case GEQUAL_OP:
+        return LEQUAL_OP;
+    }
+    return op;
+}
+
+/**
+ * @brief Narrow variable sym of st to the values where 'sym op b' holds
+ */
+static void refineVar(dc_astate *st, int sym, int op, const dc_aval &b)
+{
+    dc_aval &v = st->vars[sym];
+    switch (op)
+    {
+    case LESSER_OP:
+        if (b.hi == LLONG_MIN)
+            return kill(st);
+        v.hi = std::min(v.hi, b.hi - 1);
+        break;
+    case LEQUAL_OP:
+        v.hi = std::min(v.hi, b.hi);
+        break;
+    case GREATER_OP:
+        if (b.lo == LLONG_MAX)
+            return kill(st);
+        v.lo = std::max(v.lo, b.lo + 1);
+        break;
+    case GEQUAL_OP:
+        v.lo = std::max(v.lo, b.lo);
+        break;
+    case EQUAL_OP:
+        if (b.mod == 0)
+        {
+            if (!contains(v, b.rem))
+                return kill(st);
+            v = b;
+        }
+        v.lo = std::max(v.lo, b.lo);
+        v.hi = std::min(v.hi, b.hi);
+        break;
+    default:
+        if (b.mod == 0)
+            return exclude(st, sym, b.rem);
+        break;
+    }
+    if (!normalize(&v))
+        kill(st);
+}
+
+/**
+ * @brief Narrow st to the runs where condition e evaluates to truth.
+ *  Postfix operators have not been applied yet, so every variable in e
+ *  still holds the value the comparison saw. Evaluating e again only
+ *  refines divisors, which holds on both edges
+ */
+static void refine(const dc_absint *an, int e, bool truth, dc_astate *st)
+{
+    const dc_ast *ast = an->ast;
+    std::vector<int> ignored;
+    dc_aval c = eval(an, e, st, &ignored);
+    if (!st->live || (truth ? c.mod == 0 && c.rem == 0 : !contains(c, 0)))
+        return kill(st);
+
+    const dc_expr &ex = ast->exprs[e];
+    if (isVar(ex))
+    {
+        refineVar(st, ex.symbol, truth ? NEQUAL_OP : EQUAL_OP, constant(0));
+        return;
+    }
+    if (ex.op < LESSER_OP || ex.op > GEQUAL_OP)
+        return;
+    int op = truth ? ex.op : negate(ex.op);
+    const dc_expr &l = ast->exprs[ex.left];
+    const dc_expr &r = ast->exprs[ex.right];
+    dc_aval lv = eval(an, ex.left, st, &ignored);
+    dc_aval rv = eval(an, ex.right, st, &ignored);
+    if (isVar(l))
+        refineVar(st, l.symbol, op, rv);
+    if (st->live && isVar(r))
+        refineVar(st, r.symbol, mirror(op), lv);
+}
+
+/**
+ * @brief Bounds the loop condition e puts on its variables when it holds,
+ *  shifted by the condition's own postfix operators: the thresholds for
+ *  widening at the loop head. guards[i] belongs to syms[i]
+ */
+static void guardBounds(const dc_absint *an, int e, dc_astate *st, const std::vector<int> &syms,
+                        std::vector<dc_aval> *guards)
+{
+    const dc_ast *ast = an->ast;
+    std::vector<int> ignored;
+    std::fill(guards->begin(), guards->end(), top());
+    const dc_expr &ex = ast->exprs[e];
+    if (ex.op < LESSER_OP || ex.op > GEQUAL_OP || ex.op == EQUAL_OP || ex.op == NEQUAL_OP)
+        return;
+    for (int side = 0; side < 2; side++)
+    {
+        const dc_expr &v = ast->exprs[side ? ex.right : ex.left];
+        if (!isVar(v))
+            continue;
+        int op = side ? mirror(ex.op) : ex.op;
+        dc_aval b = eval(an, side ? ex.left : ex.right, st, &ignored);
+        wide shift = postfixNet(ast, e, v.symbol), bound;
+        dc_aval &g = (*guards)[std::lower_bound(syms.begin(), syms.end(), v.symbol) - syms.begin()];
+        if (op == LESSER_OP || op == LEQUAL_OP)
+        {
+            bound = (wide)b.hi - (op == LESSER_OP) + shift;
+            if (bound <= LLONG_MAX)
+                g.hi = (long long)bound;
+        }
+        else
+        {
+            bound = (wide)b.lo + (op == GREATER_OP) + shift;
+            if (bound >= LLONG_MIN)
+                g.lo = (long long)bound;
+        }
+    }
+}
+
+/******************************************************/
+/* Statements */
+
+/**
+ * @brief Copy the variables syms of st into the compact state part
+ */
+static void save(const dc_astate &st, const std::vector<int> &syms, dc_astate *part)
+{
+    part->live = st.live;
+    part->vars.resize(syms.size());
+    for (size_t i = 0; i < syms.size(); i++)
+        part->vars[i] = st.vars[syms[i]];
+}
+
+static void load(const dc_astate &part, const std::vector<int> &syms, dc_astate *st)
+{
+    st->live = part.live;
+    for (size_t i = 0; i < syms.size(); i++)
+        st->vars[syms[i]] = part.vars[i];
+}
+
+/**
+ * @brief Sorted symbols a statement assigns, plus those in expression e
+ */
+static void touched(const dc_ast *ast, int s, int e, std::vector<int> *syms)
+{
+    if (s >= 0)
+        collectWrites(ast, s, syms);
+    std::vector<int> work(1, e);
+    while (e >= 0 && !work.empty())
+    {
+        const dc_expr &ex = ast->exprs[work.back()];
+        work.pop_back();
+        if (isVar(ex))
+            syms->push_back(ex.symbol);
+        else if (ex.left >= 0)
+        {
+            work.push_back(ex.left);
+            work.push_back(ex.right);
+        }
+    }
+    std::sort(syms->begin(), syms->end());
+    syms->erase(std::unique(syms->begin(), syms->end()), syms->end());
+}
+
+/**
+ * @brief Fill an->sizes for the statements from first on and what they
+ *  contain
+ */
+static void measure(dc_absint *an, int first)
+{
+    const dc_ast *ast = an->ast;
+    std::vector<int> order, work(1, first);
+    // every statement lands in order before the statements of its body
+    while (!work.empty())
+    {
+        int s = work.back();
+        work.pop_back();
+        for (; s >= 0; s = ast->stmts[s].next)
+        {
+            order.push_back(s);
+            if (ast->stmts[s].body >= 0)
+                work.push_back(ast->stmts[s].body);
+        }
+    }
+    for (size_t i = order.size(); i > 0; i--)
+    {
+        size_t size = 1;
+        for (int b = ast->stmts[order[i - 1]].body; b >= 0; b = ast->stmts[b].next)
+            size += an->sizes[b];
+        an->sizes[order[i - 1]] = size;
+    }
+}
+
+/**
+ * @brief Walk a do-while: iterate its head state to a fixpoint, narrow
+ *  once, then walk the body a last time in the caller's recording mode.
+ *  Only the variables the loop assigns or tests change between rounds,
+ *  so the head states hold just those and the rest of st is left alone
+ */
+static void execLoop(dc_absint *an, int s, dc_astate *st)
+{
+    const dc_stmt &L = an->ast->stmts[s];
+    if (!st->live || an->visits > an->budget)
+        return; // over budget, the results are thrown away
+    std::vector<int> syms, postfix;
+    an->visits += an->sizes[s];
+    touched(an->ast, s, L.cond, &syms);
+    std::vector<dc_aval> guards(syms.size(), top());
+    dc_astate entry, head, back, pre;
+    bool recording = an->record;
+
+    save(*st, syms, &entry);
+    head = entry;
+    an->record = false;
+    for (int round = 0; an->visits <= an->budget; round++)
+    {
+        an->visits += syms.size();
+        load(head, syms, st);
+        execList(an, L.body, st);
+        if (st->live)
+        {
+            guardBounds(an, L.cond, st, syms, &guards);
+            postfix.clear();
+            eval(an, L.cond, st, &postfix);
+            refine(an, L.cond, true, st);
+            applyPostfix(an, postfix, st);
+        }
+        save(*st, syms, &back);
+        dc_astate next = head;
+        joinInto(&next, back);
+        widen(head, &next, round, guards);
+        if (stateWithin(next, head))
+            break;
+        head = next;
+    }
+    an->record = recording;
+    if (an->visits > an->budget)
+        return;
+    // one descending step: back came from the post-fixpoint head
+    dc_astate narrowed = entry;
+    joinInto(&narrowed, back);
+    if (stateWithin(narrowed, head))
+        head = narrowed;
+
+    load(head, syms, st);
+    execList(an, L.body, st);
+    bool tested = st->live, exits = false, repeats = false;
+    if (tested)
+    {
+        postfix.clear();
+        eval(an, L.cond, st, &postfix);
+        save(*st, syms, &pre);
+        refine(an, L.cond, true, st);
+        if ((repeats = st->live))
+            applyPostfix(an, postfix, st);
+        load(pre, syms, st);
+        refine(an, L.cond, false, st);
+        if ((exits = st->live))
+            applyPostfix(an, postfix, st);
+    }
+    if (an->record)
+    {
+        dc_loopfact &f = an->loops[s];
+        f.reached = true;
+        f.tested = f.tested || tested;
+        f.exits = f.exits || exits;
+        f.repeats = f.repeats || repeats;
+    }
+}
+
+static void execStmt(dc_absint *an, int s, dc_astate *st)
+{
+    const dc_stmt &stmt = an->ast->stmts[s];
+    std::vector<int> postfix, writes, own;
+    dc_astate snapshot, merged;
+
+    an->visits++;
+    switch (stmt.kind)
+    {
+    case ASSIGN_OP:
+    {
+        dc_aval v = eval(an, stmt.expr, st, &postfix);
+        if (!st->live)
+            return;
+        st->vars[stmt.symbol] = v;
+        record(an, stmt.symbol, v);
+        applyPostfix(an, postfix, st);
+        break;
+    }
+    case KEY_READ:
+        st->vars[stmt.symbol] = top();
+        record(an, stmt.symbol, top());
+        break;
+    case KEY_DO:
+        execLoop(an, s, st);
+        break;
+    // branches start from the same snapshot; the last one to assign a
+    // variable decides it, as every assignment in a branch runs
+    case KEY_PAR:
+        an->visits += an->sizes[s];
+        touched(an->ast, s, -1, &writes);
+        save(*st, writes, &snapshot);
+        merged = snapshot;
+        for (int b = stmt.body; b >= 0; b = an->ast->stmts[b].next)
+        {
+            an->visits += writes.size();
+            load(snapshot, writes, st);
+            execStmt(an, b, st);
+            if (!st->live)
+                return;
+            own.clear();
+            collectWrites(an->ast, b, &own);
+            for (size_t w = 0; w < own.size(); w++)
+                merged.vars[std::lower_bound(writes.begin(), writes.end(), own[w]) -
+                            writes.begin()] = st->vars[own[w]];
+        }
+        load(merged, writes, st);
+        break;
+    }
+}
+
+static void execList(dc_absint *an, int s, dc_astate *st)
+{
+    for (; s >= 0 && st->live && an->visits <= an->budget; s = an->ast->stmts[s].next)
+        execStmt(an, s, st);
+}
+
+/******************************************************/
+/* Termination */
+
+/**
+ * @brief : Interval of loop deltas in full precision; +-INF is unbounded
+ */
+struct dc_delta
+{
+    bool known;
+    wide lo, hi;
+};
+
+static dc_delta deltaOf(wide lo, wide hi)
+{
+    dc_delta d = {true, std::max(lo, -INF), std::min(hi, INF)};
+    return d;
+}
+
+static dc_delta add(const dc_delta &a, const dc_delta &b)
+{
+    if (!a.known || !b.known)
+        return a.known ? b : a;
+    return deltaOf(a.lo + b.lo, a.hi + b.hi);
+}
+
+static bool mentions(const dc_ast *ast, int e, int sym)
+{
+    std::vector<int> work(1, e);
+    while (!work.empty())
+    {
+        const dc_expr &ex = ast->exprs[work.back()];
+        work.pop_back();
+        if (isVar(ex) && ex.symbol == sym)
+            return true;
+        if (!isVar(ex) && ex.left >= 0)
+        {
+            work.push_back(ex.left);
+            work.push_back(ex.right);
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Net ++/-- of sym among the postfix operators of e
+ */
+static int postfixNet(const dc_ast *ast, int e, int sym)
+{
+    std::vector<int> work(1, e);
+    int net = 0;
+    while (!work.empty())
+    {
+        const dc_expr &ex = ast->exprs[work.back()];
+        work.pop_back();
+        if ((ex.op == INC_OP || ex.op == DEC_OP) && ex.symbol == sym)
+            net += ex.op == INC_OP ? 1 : -1;
+        else if (ex.left >= 0)
+        {
+            work.push_back(ex.left);
+            work.push_back(ex.right);
+        }
+    }
+    return net;
+}
+
+/**
+ * @brief Range of e anywhere in the program: variables hold 0 or a value
+ *  assigned to them
+ */
+static dc_delta anywhere(const dc_absint *an, int e)
+{
+    std::vector<int> ignored, syms;
+    dc_astate &st = an->scratch;
+    st.live = true;
+    st.vars.resize(an->held.size());
+    touched(an->ast, -1, e, &syms);
+    for (size_t i = 0; i < syms.size(); i++)
+        st.vars[syms[i]] = an->assigned[syms[i]] ? join(an->held[syms[i]], constant(0))
+                                                 : constant(0);
+    dc_aval v = eval(an, e, &st, &ignored);
+    return deltaOf(v.lo, v.hi);
+}
+
+/**
+ * @brief e as the value of sym before the statement plus a delta: sym
+ *  reached through + and - alone, on the left of a - and with sym in no
+ *  other operand
+ */
+static dc_delta relative(const dc_absint *an, int e, int sym)
+{
+    const dc_ast *ast = an->ast;
+    dc_delta none = {false, 0, 0}, d = deltaOf(0, 0);
+    std::vector<int> path; // the operators down to sym
+    while (!isVar(ast->exprs[e]))
+    {
+        const dc_expr &ex = ast->exprs[e];
+        if (ex.op != ADD_OP && ex.op != SUB_OP)
+            return none;
+        path.push_back(e);
+        if (!mentions(ast, ex.right, sym))
+            e = ex.left;
+        else if (ex.op == ADD_OP && !mentions(ast, ex.left, sym))
+            e = ex.right;
+        else
+            return none;
+    }
+    if (ast->exprs[e].symbol != sym)
+        return none;
+    // the other operands, innermost first
+    for (size_t i = path.size(); i > 0; i--)
+    {
+        const dc_expr &ex = ast->exprs[path[i - 1]];
+        if (ex.left == e)
+        {
+            dc_delta r = anywhere(an, ex.right);
+            d = ex.op == ADD_OP ? add(d, r) : add(d, deltaOf(-r.hi, -r.lo));
+        }
+        else
+            d = add(anywhere(an, ex.left), d);
+        e = path[i - 1];
+    }
+    return d;
+}
+
+static dc_delta stepList(const dc_absint *an, int s, int sym);
+
+/**
+ * @brief How much one run of statement s moves sym
+ */
+static dc_delta step(const dc_absint *an, int s, int sym)
+{
+    const dc_ast *ast = an->ast;
+    const dc_stmt &st = ast->stmts[s];
+    dc_delta none = {false, 0, 0}, d = deltaOf(0, 0), r;
+    std::vector<int> writes;
+
+    switch (st.kind)
+    {
+    case ASSIGN_OP:
+        if (st.symbol == sym && !(d = relative(an, st.expr, sym)).known)
+            return none;
+        return add(d, deltaOf(postfixNet(ast, st.expr, sym), postfixNet(ast, st.expr, sym)));
+    case KEY_READ:
+        return st.symbol == sym ? none : d;
+    case KEY_DO:
+        // at least one iteration, each moving sym by r
+        r = add(stepList(an, st.body, sym),
+                deltaOf(postfixNet(ast, st.cond, sym), postfixNet(ast, st.cond, sym)));
+        if (!r.known)
+            return none;
+        if (r.lo >= 0)
+            return deltaOf(r.lo, r.hi == 0 ? 0 : INF);
+        if (r.hi <= 0)
+            return deltaOf(-INF, r.hi);
+        return none;
+    case KEY_PAR:
+        // the last branch that assigns sym decides it
+        for (int b = st.body; b >= 0; b = ast->stmts[b].next)
+        {
+            writes.clear();
+            collectWrites(ast, b, &writes);
+            if (std::find(writes.begin(), writes.end(), sym) != writes.end())
+                d = step(an, b, sym);
+        }
+        return d;
+    }
+    return d;
+}
+
+static dc_delta stepList(const dc_absint *an, int s, int sym)
+{
+    dc_delta d = deltaOf(0, 0);
+    for (; s >= 0 && d.known; s = an->ast->stmts[s].next)
+        d = add(d, step(an, s, sym));
+    return d;
+}
+
+/**
+ * @brief Does loop s stop after finitely many iterations of its own,
+ *  with a counter in its condition. Sets *counter to it
+ */
+static bool counts(const dc_absint *an, int s, int *counter)
+{
+    const dc_ast *ast = an->ast;
+    const dc_stmt &L = ast->stmts[s];
+    const dc_expr &c = ast->exprs[L.cond];
+    if (c.op < LESSER_OP || c.op > GEQUAL_OP || c.op == EQUAL_OP || c.op == NEQUAL_OP)
+        return false;
+
+    std::vector<int> writes;
+    collectWrites(ast, s, &writes);
+    int op = c.op, var = c.left, bound = c.right;
+    for (int side = 0; side < 2; side++)
+    {
+        if (side == 1)
+        {
+            op = mirror(c.op);
+            var = c.right;
+            bound = c.left;
+        }
+        const dc_expr &v = ast->exprs[var];
+        if (!isVar(v))
+            continue;
+        bool invariant = true;
+        for (size_t w = 0; w < writes.size() && invariant; w++)
+            invariant = !mentions(ast, bound, writes[w]);
+        if (!invariant)
+            continue;
+
+        // the value tested moves by d per iteration and must not wrap
+        // past the bound on its way there
+        int net = postfixNet(ast, L.cond, v.symbol);
+        dc_delta d = add(stepList(an, L.body, v.symbol), deltaOf(net, net));
+        dc_delta n = anywhere(an, bound);
+        if (!d.known)
+            continue;
+        bool finite = false;
+        switch (op)
+        {
+        case LESSER_OP:
+            finite = d.lo >= 1 && n.hi - 1 + d.hi <= LLONG_MAX;
+            break;
+        case LEQUAL_OP:
+            finite = d.lo >= 1 && n.hi + d.hi <= LLONG_MAX;
+            break;
+        case GREATER_OP:
+            finite = d.hi <= -1 && n.lo + 1 + d.lo >= LLONG_MIN;
+            break;
+        case GEQUAL_OP:
+            finite = d.hi <= -1 && n.lo + d.lo >= LLONG_MIN;
+            break;
+        }
+        if (finite)
+        {
+            *counter = v.symbol;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Add a verdict for a loop
+ */
+static void verdict(std::vector<dc_diag_rec> *found, dc_diag_kind kind,
+                    const std::string &message, size_t offset)
+{
+    dc_diag_rec d;
+    d.kind = kind;
+    d.message = message;
+    d.offset = offset;
+    d.lexBefore = 0;
+    found->push_back(d);
+}
+
+/**
+ * @brief Judge every loop in list s, innermost first; returns whether all
+ *  of them are proven finite
+ */
+static bool verdicts(dc_context *ctx, const dc_absint *an, int s,
+                     std::vector<dc_diag_rec> *found)
+{
+    bool allFinite = true;
+    for (; s >= 0; s = an->ast->stmts[s].next)
+    {
+        const dc_stmt &st = an->ast->stmts[s];
+        if (st.kind == KEY_PAR)
+            allFinite = verdicts(ctx, an, st.body, found) && allFinite;
+        if (st.kind != KEY_DO)
+            continue;
+        bool inner = verdicts(ctx, an, st.body, found);
+        const dc_loopfact &f = an->loops[s];
+        std::string at;
+        int counter;
+        where(ctx, st.offset, &at);
+        if (f.tested && !f.exits)
+        {
+            allFinite = false;
+            verdict(found, DC_DIAG_WARNING,
+                    "warning: do-while" + at + " never terminates: its condition is always true",
+                    st.offset);
+        }
+        else if (f.reached && f.tested && !f.repeats)
+            verdict(found, DC_DIAG_NOTE,
+                    "note: do-while" + at + " terminates: its condition is never true",
+                    st.offset);
+        else if (f.reached && inner && counts(an, s, &counter))
+            verdict(found, DC_DIAG_NOTE,
+                    "note: do-while" + at + " terminates: '" + dc_symbol_name(ctx, counter) +
+                        "' moves toward a fixed bound",
+                    st.offset);
+        else
+            allFinite = false;
+    }
+    return allFinite;
+}
+
+static bool byOffset(const dc_diag_rec &a, const dc_diag_rec &b)
+{
+    return a.offset < b.offset;
+}
+
+/**
+ * @brief Prove loops finite or infinite and report the range of every
+ *  variable
+ * @return int : number of loops proven infinite
+ */
+int dc_analyze(dc_context *ctx)
+{
+    if (ctx->exit_code != NoError)
+        return 0;
+
+    const size_t nsyms = ctx->symbols.syms.size();
+    dc_absint an;
+    an.ast = &ctx->ast;
+    an.held.assign(nsyms, constant(0));
+    an.assigned.assign(nsyms, 0);
+    dc_loopfact none = {false, false, false, false};
+    an.loops.assign(ctx->ast.stmts.size(), none);
+    an.record = true;
+    an.visits = 0;
+    an.budget = WORK_CAP + BUDGET * ctx->ast.stmts.size();
+    an.sizes.resize(ctx->ast.stmts.size());
+    measure(&an, ctx->ast.first);
+
+    dc_astate st;
+    st.live = true;
+    st.vars.assign(nsyms, constant(0));
+    execList(&an, ctx->ast.first, &st);
+    if (an.visits > an.budget)
+    {
+        report(ctx, DC_DIAG_NOTE, "note: analysis stopped: the program is too large or too deeply nested");
+        return 0;
+    }
+
+    // a read that may come before the first assignment sees the initial 0
+    std::vector<dc_early> early;
+    earlyReads(&ctx->ast, nsyms, &early, NULL);
+    for (size_t v = 0; v < nsyms; v++)
+        if (an.assigned[v] && early[v].found)
+            an.held[v] = join(an.held[v], constant(0));
+
+    // in source order, outer loops before the loops they contain
+    std::vector<dc_diag_rec> found;
+    int infinite = 0;
+    verdicts(ctx, &an, ctx->ast.first, &found);
+    std::stable_sort(found.begin(), found.end(), byOffset);
+    for (size_t i = 0; i < found.size(); i++)
+    {
+        infinite += found[i].kind == DC_DIAG_WARNING;
+        report(ctx, found[i].kind, found[i].message, found[i].offset);
+    }
+    for (size_t v = 0; v < nsyms; v++)
+    {
+        const dc_aval &r = an.held[v];
+        std::string text = std::string("note: '") + dc_symbol_name(ctx, (int)v) + "'";
+        if (!an.assigned[v])
+            text += " is always 0 (no assignment to it runs)";
+        else if (r.mod == 0)
+            text += " is always " + std::to_string(r.rem);
+        else if (r.lo == LLONG_MIN && r.hi == LLONG_MAX && r.mod == 1)
+            text += " can hold any value";
+        else
+        {
+            text += " is in [" + std::to_string(r.lo) + ", " + std::to_string(r.hi) + "]";
+            if (r.mod > 1)
+                text += ", " + std::to_string(r.rem) + " mod " + std::to_string(r.mod);
+        }
+        report(ctx, DC_DIAG_NOTE, text);
+    }
+    return infinite;
+}
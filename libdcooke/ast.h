@@ -0,0 +1,64 @@
+/*
+=============================================================================
+Title : ast.h
+Description : Abstract syntax tree built by the parser for later analyses.
+Author : silrodri (R#11679913)
+Date : 10/19/2026
+Version : 2.0
+Usage : Internal to libdcooke; filled by parser.cpp during dc_parse()
+Notes : Nodes live in flat vectors and refer to each other by index (-1 for
+        none). Node kinds reuse the token codes from front.h.
+C++ Version : cpp (GCC) 4.8.5 20150623 (Red Hat 4.8.5-16)
+=============================================================================
+*/
+#ifndef AST_H
+#define AST_H
+
+#include <stddef.h>
+#include <vector>
+
+/**
+ * @brief : Statement node; kind is the token that introduces it
+ *  ASSIGN_OP  : symbol = expr
+ *  KEY_READ   : read(symbol)
+ *  KEY_WRITE  : write(symbol)
+ *  KEY_DO     : do { body } while (cond)
+ *  KEY_PAR    : par { body }, each statement of body is one branch
+ */
+struct dc_stmt
+{
+    int kind;
+    int symbol;
+    int expr;
+    int body;
+    int cond;
+    int next;      // following statement of the same list
+    size_t offset; // byte offset of the first token
+};
+
+/**
+ * @brief : Expression node; op is a token code
+ *  INT_LIT             : value
+ *  IDENT               : symbol
+ *  INC_OP / DEC_OP     : symbol++ / symbol-- (postfix)
+ *  ADD_OP .. DIV_OP    : left op right
+ *  LESSER_OP .. GEQUAL_OP : left op right (conditions only)
+ */
+struct dc_expr
+{
+    int op;
+    int left;
+    int right;
+    int symbol;
+    long long value;
+    size_t offset;
+};
+
+struct dc_ast
+{
+    std::vector<dc_stmt> stmts;
+    std::vector<dc_expr> exprs;
+    int first; // first top-level statement
+};
+
+#endif
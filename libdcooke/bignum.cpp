@@ -0,0 +1,234 @@
+/*
+=============================================================================
+Title : bignum.cpp
+Description : Arbitrary-precision integers for exact dc_run arithmetic.
+Author : silrodri (R#11679913)
+Date : 10/19/2026
+Version : 2.0
+Usage : Built into libdcooke; see bignum.h
+Notes : Schoolbook algorithms on 32-bit limbs. Only values that have left
+        the long long range get here, so simplicity wins over speed: the
+        division of two multi-limb numbers goes one bit at a time.
+C++ Version : cpp (GCC) 4.8.5 20150623 (Red Hat 4.8.5-16)
+=============================================================================
+*/
+#include <algorithm>
+
+#include "bignum.h"
+
+typedef std::vector<unsigned> dc_limbs;
+
+static void trim(dc_limbs *m)
+{
+    while (!m->empty() && m->back() == 0)
+        m->pop_back();
+}
+
+static int magCompare(const dc_limbs &a, const dc_limbs &b)
+{
+    if (a.size() != b.size())
+        return a.size() < b.size() ? -1 : 1;
+    for (size_t i = a.size(); i-- > 0;)
+        if (a[i] != b[i])
+            return a[i] < b[i] ? -1 : 1;
+    return 0;
+}
+
+static void magAdd(const dc_limbs &a, const dc_limbs &b, dc_limbs *r)
+{
+    const dc_limbs &big = a.size() >= b.size() ? a : b;
+    const dc_limbs &small = a.size() >= b.size() ? b : a;
+    dc_limbs sum(big.size() + 1);
+    unsigned long long carry = 0;
+    for (size_t i = 0; i < big.size(); i++)
+    {
+        carry += (unsigned long long)big[i] + (i < small.size() ? small[i] : 0);
+        sum[i] = (unsigned)carry;
+        carry >>= 32;
+    }
+    sum[big.size()] = (unsigned)carry;
+    trim(&sum);
+    r->swap(sum);
+}
+
+/**
+ * @brief r = a - b for magnitudes with a >= b
+ */
+static void magSub(const dc_limbs &a, const dc_limbs &b, dc_limbs *r)
+{
+    dc_limbs diff(a.size());
+    long long borrow = 0;
+    for (size_t i = 0; i < a.size(); i++)
+    {
+        long long d = (long long)a[i] - (i < b.size() ? b[i] : 0) - borrow;
+        borrow = d < 0;
+        diff[i] = (unsigned)(d + (borrow << 32));
+    }
+    trim(&diff);
+    r->swap(diff);
+}
+
+static void magMul(const dc_limbs &a, const dc_limbs &b, dc_limbs *r)
+{
+    dc_limbs prod(a.size() + b.size());
+    for (size_t i = 0; i < a.size(); i++)
+    {
+        unsigned long long carry = 0;
+        for (size_t j = 0; j < b.size(); j++)
+        {
+            carry += (unsigned long long)a[i] * b[j] + prod[i + j];
+            prod[i + j] = (unsigned)carry;
+            carry >>= 32;
+        }
+        prod[i + b.size()] = (unsigned)carry;
+    }
+    trim(&prod);
+    r->swap(prod);
+}
+
+/**
+ * @brief q = a / d for a one-limb divisor; returns the remainder
+ */
+static unsigned magDivSmall(const dc_limbs &a, unsigned d, dc_limbs *q)
+{
+    dc_limbs quot(a.size());
+    unsigned long long rem = 0;
+    for (size_t i = a.size(); i-- > 0;)
+    {
+        rem = rem << 32 | a[i];
+        quot[i] = (unsigned)(rem / d);
+        rem %= d;
+    }
+    trim(&quot);
+    q->swap(quot);
+    return (unsigned)rem;
+}
+
+static void magDiv(const dc_limbs &a, const dc_limbs &b, dc_limbs *q)
+{
+    if (b.size() == 1)
+    {
+        magDivSmall(a, b[0], q);
+        return;
+    }
+    dc_limbs quot(a.size()), rem;
+    for (size_t bit = a.size() * 32; bit-- > 0;)
+    {
+        // rem = rem * 2 + the next bit of a
+        unsigned carry = a[bit / 32] >> (bit % 32) & 1;
+        for (size_t i = 0; i < rem.size(); i++)
+        {
+            unsigned top = rem[i] >> 31;
+            rem[i] = rem[i] << 1 | carry;
+            carry = top;
+        }
+        if (carry)
+            rem.push_back(carry);
+        if (magCompare(rem, b) >= 0)
+        {
+            magSub(rem, b, &rem);
+            quot[bit / 32] |= 1u << (bit % 32);
+        }
+    }
+    trim(&quot);
+    q->swap(quot);
+}
+
+void bigSet(dc_bignum *r, long long v)
+{
+    unsigned long long m = v < 0 ? 0 - (unsigned long long)v : (unsigned long long)v;
+    r->negative = v < 0;
+    r->limbs.clear();
+    for (; m != 0; m >>= 32)
+        r->limbs.push_back((unsigned)m);
+}
+
+bool bigSmall(const dc_bignum &a, long long *v)
+{
+    if (a.limbs.size() > 2)
+        return false;
+    unsigned long long m = 0;
+    for (size_t i = a.limbs.size(); i-- > 0;)
+        m = m << 32 | a.limbs[i];
+    if (a.negative ? m > (unsigned long long)LLONG_MAX + 1 : m > (unsigned long long)LLONG_MAX)
+        return false;
+    *v = a.negative ? (long long)(0 - m) : (long long)m;
+    return true;
+}
+
+int bigCompare(const dc_bignum &a, const dc_bignum &b)
+{
+    if (a.negative != b.negative)
+        return a.negative ? -1 : 1;
+    int c = magCompare(a.limbs, b.limbs);
+    return a.negative ? -c : c;
+}
+
+/**
+ * @brief r = a + b, with b negated when flip is set
+ */
+static void addSigned(const dc_bignum &a, const dc_bignum &b, bool flip, dc_bignum *r)
+{
+    bool bNegative = b.negative != flip && !b.limbs.empty();
+    if (a.negative == bNegative)
+    {
+        magAdd(a.limbs, b.limbs, &r->limbs);
+        r->negative = a.negative;
+    }
+    else if (magCompare(a.limbs, b.limbs) >= 0)
+    {
+        bool sign = a.negative;
+        magSub(a.limbs, b.limbs, &r->limbs);
+        r->negative = sign;
+    }
+    else
+    {
+        magSub(b.limbs, a.limbs, &r->limbs);
+        r->negative = bNegative;
+    }
+    if (r->limbs.empty())
+        r->negative = false;
+}
+
+void bigAdd(const dc_bignum &a, const dc_bignum &b, dc_bignum *r)
+{
+    addSigned(a, b, false, r);
+}
+
+void bigSub(const dc_bignum &a, const dc_bignum &b, dc_bignum *r)
+{
+    addSigned(a, b, true, r);
+}
+
+void bigMul(const dc_bignum &a, const dc_bignum &b, dc_bignum *r)
+{
+    bool sign = a.negative != b.negative;
+    magMul(a.limbs, b.limbs, &r->limbs);
+    r->negative = sign && !r->limbs.empty();
+}
+
+void bigDiv(const dc_bignum &a, const dc_bignum &b, dc_bignum *r)
+{
+    bool sign = a.negative != b.negative;
+    magDiv(a.limbs, b.limbs, &r->limbs);
+    r->negative = sign && !r->limbs.empty();
+}
+
+std::string bigText(const dc_bignum &a)
+{
+    if (a.limbs.empty())
+        return "0";
+    std::string digits;
+    dc_limbs m = a.limbs;
+    while (!m.empty())
+    {
+        // nine decimal digits at a time
+        unsigned chunk = magDivSmall(m, 1000000000u, &m);
+        for (int i = 0; i < 9 && (chunk != 0 || !m.empty()); i++, chunk /= 10)
+            digits += (char)('0' + chunk % 10);
+    }
+    if (a.negative)
+        digits += '-';
+    std::reverse(digits.begin(), digits.end());
+    return digits;
+}
@@ -0,0 +1,78 @@
+/*
+=============================================================================
+Title : bignum.h
+Description : Arbitrary-precision integers for exact dc_run arithmetic.
+Author : silrodri (R#11679913)
+Date : 10/19/2026
+Version : 2.0
+Usage : Internal to libdcooke; used by exec.cpp when dc_set_exact() is on
+Notes : An exact run keeps every value in a long long and checks each
+        operation for overflow. A value that does not fit is stored as
+        DC_BIG, with the number itself in a dc_bignum beside the slot, and
+        goes back to a plain long long as soon as it fits again. DC_BIG is
+        LLONG_MIN, so LLONG_MIN itself is always boxed; that keeps the fast
+        path to one compare per operand.
+C++ Version : cpp (GCC) 4.8.5 20150623 (Red Hat 4.8.5-16)
+=============================================================================
+*/
+#ifndef BIGNUM_H
+#define BIGNUM_H
+
+#include <climits>
+#include <string>
+#include <vector>
+
+#define DC_BIG LLONG_MIN // the value is in the dc_bignum beside the slot
+
+/**
+ * @brief : Sign and magnitude; limbs are base 2^32, least significant
+ *  first, with no leading zero limbs (zero has none)
+ */
+struct dc_bignum
+{
+    bool negative;
+    std::vector<unsigned> limbs;
+};
+
+/* Overflow-checked long long arithmetic: true when the result wrapped */
+#if defined(__clang__) || __GNUC__ >= 5
+static inline bool addOverflow(long long a, long long b, long long *r)
+{
+    return __builtin_add_overflow(a, b, r);
+}
+static inline bool subOverflow(long long a, long long b, long long *r)
+{
+    return __builtin_sub_overflow(a, b, r);
+}
+static inline bool mulOverflow(long long a, long long b, long long *r)
+{
+    return __builtin_mul_overflow(a, b, r);
+}
+#else
+static inline bool addOverflow(long long a, long long b, long long *r)
+{
+    *r = (long long)((unsigned long long)a + (unsigned long long)b);
+    return (a >= 0) == (b >= 0) && (*r >= 0) != (a >= 0);
+}
+static inline bool subOverflow(long long a, long long b, long long *r)
+{
+    *r = (long long)((unsigned long long)a - (unsigned long long)b);
+    return (a >= 0) != (b >= 0) && (*r >= 0) != (a >= 0);
+}
+static inline bool mulOverflow(long long a, long long b, long long *r)
+{
+    *r = (long long)((unsigned long long)a * (unsigned long long)b);
+    return a != 0 && ((a == -1 && b == LLONG_MIN) || *r / a != b);
+}
+#endif
+
+void bigSet(dc_bignum *r, long long v);
+bool bigSmall(const dc_bignum &a, long long *v); // fits a long long
+int bigCompare(const dc_bignum &a, const dc_bignum &b);
+void bigAdd(const dc_bignum &a, const dc_bignum &b, dc_bignum *r);
+void bigSub(const dc_bignum &a, const dc_bignum &b, dc_bignum *r);
+void bigMul(const dc_bignum &a, const dc_bignum &b, dc_bignum *r);
+void bigDiv(const dc_bignum &a, const dc_bignum &b, dc_bignum *r); // truncates; b != 0
+std::string bigText(const dc_bignum &a);
+
+#endif
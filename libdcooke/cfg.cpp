@@ -0,0 +1,225 @@
+/*
+=============================================================================
+Title : cfg.cpp
+Description : Control-flow graph of a parsed DCooke program.
+Author : silrodri (R#11679913)
+Date : 10/19/2026
+Version : 2.0
+Usage : Built into libdcooke; see cfg.h
+Notes : A do-while starts a new block (its back edge target) and ends with
+        the condition, whose block branches back to the head or falls out.
+C++ Version : cpp (GCC) 4.8.5 20150623 (Red Hat 4.8.5-16)
+=============================================================================
+*/
+#include "cfg.h"
+#include "front.h"
+
+static void emitList(const dc_ast *ast, dc_cfg *cfg, int s, int *cur);
+
+/**
+ * @brief Open a new empty block and return its number
+ */
+static int newBlock(dc_cfg *cfg)
+{
+    dc_block b;
+    b.firstEvent = b.endEvent = cfg->events.size();
+    b.succ[0] = b.succ[1] = -1;
+    cfg->blocks.push_back(b);
+    return (int)cfg->blocks.size() - 1;
+}
+
+/**
+ * @brief Add an edge from block 'from' to block 'to'
+ */
+static void link(dc_cfg *cfg, int from, int to)
+{
+    dc_block &b = cfg->blocks[from];
+    b.succ[b.succ[0] < 0 ? 0 : 1] = to;
+}
+
+/**
+ * @brief Append an event to the current (last) block
+ */
+static void emit(dc_cfg *cfg, int kind, int symbol, size_t offset)
+{
+    dc_event ev;
+    ev.kind = kind;
+    ev.symbol = symbol;
+    ev.offset = offset;
+    cfg->events.push_back(ev);
+    cfg->blocks.back().endEvent = cfg->events.size();
+}
+
+/**
+ * @brief Emit the reads of an expression left to right, collecting its
+ *  postfix writes
+ */
+static void emitExpr(const dc_ast *ast, dc_cfg *cfg, int e, std::vector<int> *postfix)
+{
+    std::vector<int> work(1, e);
+    while (e >= 0 && !work.empty())
+    {
+        e = work.back();
+        work.pop_back();
+        const dc_expr &ex = ast->exprs[e];
+        switch (ex.op)
+        {
+        case INT_LIT:
+            break;
+        case IDENT:
+            emit(cfg, DC_EV_USE, ex.symbol, ex.offset);
+            break;
+        case INC_OP:
+        case DEC_OP:
+            emit(cfg, DC_EV_USE, ex.symbol, ex.offset);
+            postfix->push_back(e);
+            break;
+        default:
+            work.push_back(ex.right);
+            work.push_back(ex.left);
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Emit the writes of postfix operators once their statement is done
+ */
+static void emitPostfix(const dc_ast *ast, dc_cfg *cfg, const std::vector<int> &postfix)
+{
+    for (size_t i = 0; i < postfix.size(); i++)
+    {
+        const dc_expr &ex = ast->exprs[postfix[i]];
+        emit(cfg, DC_EV_DEF, ex.symbol, ex.offset);
+    }
+}
+
+/**
+ * @brief Collect every variable a statement (and its body) assigns
+ */
+void collectWrites(const dc_ast *ast, int s, std::vector<int> *writes)
+{
+    std::vector<int> stmts(1, s), body, exprs; // ~s: the expressions of s
+    while (!stmts.empty())
+    {
+        s = stmts.back();
+        stmts.pop_back();
+        if (s >= 0)
+        {
+            // the statement, its body in order, then its own expressions
+            const dc_stmt &st = ast->stmts[s];
+            if (st.kind == ASSIGN_OP || st.kind == KEY_READ)
+                writes->push_back(st.symbol);
+            stmts.push_back(~s);
+            body.clear();
+            for (int b = st.body; b >= 0; b = ast->stmts[b].next)
+                body.push_back(b);
+            stmts.insert(stmts.end(), body.rbegin(), body.rend());
+            continue;
+        }
+        const dc_stmt &st = ast->stmts[~s];
+        if (st.expr >= 0)
+            exprs.push_back(st.expr);
+        if (st.cond >= 0)
+            exprs.push_back(st.cond);
+        while (!exprs.empty())
+        {
+            const dc_expr &ex = ast->exprs[exprs.back()];
+            exprs.pop_back();
+            if (ex.op == INC_OP || ex.op == DEC_OP)
+                writes->push_back(ex.symbol);
+            if (ex.left >= 0)
+                exprs.push_back(ex.left);
+            if (ex.right >= 0)
+                exprs.push_back(ex.right);
+        }
+    }
+}
+
+/**
+ * @brief Emit one statement into block *cur, opening blocks for loops
+ */
+static void emitStmt(const dc_ast *ast, dc_cfg *cfg, int s, int *cur)
+{
+    const dc_stmt &st = ast->stmts[s];
+    std::vector<int> postfix, writes;
+    std::vector<int> ends;
+    int head, exit, fork;
+
+    switch (st.kind)
+    {
+    case ASSIGN_OP:
+        emitExpr(ast, cfg, st.expr, &postfix);
+        emit(cfg, DC_EV_DEF, st.symbol, st.offset);
+        emitPostfix(ast, cfg, postfix);
+        break;
+    case KEY_READ:
+        emit(cfg, DC_EV_DEF, st.symbol, st.offset);
+        break;
+    case KEY_WRITE:
+        emit(cfg, DC_EV_USE, st.symbol, st.offset);
+        break;
+    case KEY_DO:
+        head = newBlock(cfg);
+        link(cfg, *cur, head);
+        *cur = head;
+        emitList(ast, cfg, st.body, cur);
+        emitExpr(ast, cfg, st.cond, &postfix);
+        emitPostfix(ast, cfg, postfix);
+        exit = newBlock(cfg);
+        link(cfg, *cur, head); // condition true: run the body again
+        link(cfg, *cur, exit);
+        *cur = exit;
+        break;
+    // every branch starts from the state before the par: a chain of empty
+    // fork blocks fans out to them. DCooke has no conditional statements,
+    // so each assignment of a branch runs, and its value is merged at the
+    // join: the join block defines every variable the branches assign.
+    case KEY_PAR:
+        fork = *cur;
+        for (int b = st.body; b >= 0; b = ast->stmts[b].next)
+        {
+            head = newBlock(cfg);
+            link(cfg, fork, head);
+            *cur = head;
+            emitStmt(ast, cfg, b, cur);
+            ends.push_back(*cur);
+            collectWrites(ast, b, &writes);
+            if (ast->stmts[b].next >= 0)
+            {
+                head = newBlock(cfg);
+                link(cfg, fork, head);
+                fork = head;
+            }
+        }
+        exit = newBlock(cfg);
+        for (size_t i = 0; i < ends.size(); i++)
+            link(cfg, ends[i], exit);
+        if (ends.empty())
+            link(cfg, fork, exit);
+        *cur = exit;
+        for (size_t i = 0; i < writes.size(); i++)
+            emit(cfg, DC_EV_DEF, writes[i], st.offset);
+        break;
+    }
+}
+
+/**
+ * @brief Emit a statement list in order
+ */
+static void emitList(const dc_ast *ast, dc_cfg *cfg, int s, int *cur)
+{
+    for (; s >= 0; s = ast->stmts[s].next)
+        emitStmt(ast, cfg, s, cur);
+}
+
+/**
+ * @brief Build the control-flow graph of a whole program
+ */
+void buildCfg(const dc_ast *ast, dc_cfg *cfg)
+{
+    cfg->blocks.clear();
+    cfg->events.clear();
+    int cur = newBlock(cfg);
+    emitList(ast, cfg, ast->first, &cur);
+}
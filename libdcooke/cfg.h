@@ -0,0 +1,73 @@
+/*
+=============================================================================
+Title : cfg.h
+Description : Control-flow graph of a parsed DCooke program.
+Author : silrodri (R#11679913)
+Date : 10/19/2026
+Version : 2.0
+Usage : Internal to libdcooke; built from the AST by buildCfg()
+Notes : Each basic block holds the variable reads (uses) and writes (defs)
+        of its statements in execution order. Postfix ++/-- writes land
+        after the assignment of their statement. A par fans out to its
+        branches and joins in a block that defines what they assign.
+C++ Version : cpp (GCC) 4.8.5 20150623 (Red Hat 4.8.5-16)
+=============================================================================
+*/
+#ifndef CFG_H
+#define CFG_H
+
+#include <stddef.h>
+#include <vector>
+
+#include "ast.h"
+
+#define DC_EV_USE 0
+#define DC_EV_DEF 1
+
+struct dc_event
+{
+    int kind; // DC_EV_USE or DC_EV_DEF
+    int symbol;
+    size_t offset; // source byte offset of the access
+};
+
+/**
+ * @brief : Basic block; events[firstEvent, endEvent) run in order, then
+ *  control moves to succ[0] and/or succ[1] (-1 when absent)
+ */
+struct dc_block
+{
+    size_t firstEvent;
+    size_t endEvent;
+    int succ[2];
+};
+
+/**
+ * @brief : Block 0 is the entry; blocks are numbered in program order, so
+ *  every edge except a do-while back edge goes to a higher number
+ */
+struct dc_cfg
+{
+    std::vector<dc_block> blocks;
+    std::vector<dc_event> events;
+};
+
+/**
+ * @brief : First read of a variable that may run before it is assigned;
+ *  reached is set when some assignment can also reach that read
+ */
+struct dc_early
+{
+    bool found;
+    bool reached;
+    size_t offset;
+};
+
+void buildCfg(const dc_ast *ast, dc_cfg *cfg);
+void collectWrites(const dc_ast *ast, int s, std::vector<int> *writes);
+
+/* uninit.cpp */
+void earlyReads(const dc_ast *ast, size_t nsyms, std::vector<dc_early> *early,
+                std::vector<int> *order);
+
+#endif
@@ -0,0 +1,138 @@
+/*
+=============================================================================
+Title : context.h
+Description : Internal state of a libdcooke context (lexer + parser).
+Author : silrodri (R#11679913)
+Date : 10/19/2026
+Version : 2.0
+Usage : Included by the library sources only; clients use dcooke.h
+Notes : Replaces the globals that used to live in main.cpp / parser.cpp.
+C++ Version : cpp (GCC) 4.8.5 20150623 (Red Hat 4.8.5-16)
+=============================================================================
+*/
+#ifndef CONTEXT_H
+#define CONTEXT_H
+
+#include <string>
+#include <vector>
+
+#include "ast.h"
+#include "dcooke.h"
+#include "sha256.h"
+#include "symtab.h"
+
+/**
+ * @brief : A scanned token; the lexeme lives in dc_context::lexemes
+ */
+struct dc_token_rec
+{
+    int code;
+    size_t lexemeAt; // index of the NUL-terminated lexeme in lexemes
+    size_t offset;   // byte offset of the first character in the source
+    long long value; // decoded value of an INT_LIT, 0 otherwise
+    int symbol;      // dense symbol ID of an IDENT, -1 otherwise
+};
+
+/**
+ * @brief : A diagnostic raised while scanning or parsing
+ */
+struct dc_diag_rec
+{
+    dc_diag_kind kind;
+    std::string message;
+    size_t offset;    // source byte offset, or DC_NO_OFFSET
+    size_t lexBefore; // pipelined parse: lexer diagnostics raised before it
+};
+
+/**
+ * @brief : An entry of the expression parser's stacks: an operand (an
+ *  expression node, -1 after an error) or a pending operator token, with
+ *  the offset of the first token it covers
+ */
+struct dc_exprslot
+{
+    int code;
+    size_t at;
+};
+
+struct dc_tokring;
+
+struct dc_context
+{
+    /* Input */
+    std::vector<char> src;
+    size_t pos;
+    dc_pull_fn pull; // source of more input, see dc_set_source()
+    void *pullUser;
+
+    /* Newline index for dc_locate(), built on first use (lines.cpp) */
+    std::vector<size_t> newlines; // offset of every '\n' in src[0, indexed)
+    size_t indexed;
+
+    /* Lexer state (formerly the globals of main.cpp) */
+    int lexLen;
+    size_t tokenStart;
+    long long intValue; // value of the last INT_LIT scanned
+    int symbol;         // symbol ID of the last IDENT scanned
+    char lexeme[100];
+
+    /* Parser state (formerly the globals of parser.cpp) */
+    dc_tokring *ring; // pipelined parse: lex() takes tokens from here
+    size_t lexDiags;  // and the lexer had raised this many diagnostics
+    int nextToken;
+    const char *strNextToken;
+    exitCode exit_code;
+    exitCode shadowCode;
+    std::vector<dc_exprslot> operands, operators; // expression parser stacks
+
+    /* Hardened mode caps (0 = unlimited) */
+    dc_limits limits;
+    size_t depth;
+    size_t parDepth; // par bodies open (read is not allowed in them)
+
+    /* Results */
+    std::vector<dc_token_rec> tokens;
+    std::vector<char> lexemes;
+    std::vector<dc_diag_rec> diags;
+    std::vector<std::string> spare; // message buffers of cleared diags
+    std::string message;            // the syntax error being written
+    dc_symtab symbols;
+    dc_ast ast;
+
+    /* Statement profile of dc_run (profile.cpp): starts of statement s at
+       hits[s], condition tests of do-while s at hits[stmts + s] */
+    bool profiling;
+    std::vector<unsigned long long> hits;
+
+    /* dc_run tries closed forms of loops (indvar.cpp), until the next parse */
+    bool closedForms;
+
+    /* Token hash and SHA-256 of the last dc_format (format.cpp), zero after
+       any other run */
+    unsigned long long tokenHash;
+    unsigned char tokenDigest[DC_SHA256_BYTES];
+
+    /* dc_run computes exactly (bignum.h); exactText gets the big writes */
+    bool exact;
+    dc_write_text_fn exactText;
+};
+
+/* lexer.cpp */
+void lexBegin(dc_context *ctx);
+int lex(dc_context *ctx);
+int scan(dc_context *ctx);
+
+/* pipeline.cpp */
+int takeToken(dc_context *ctx);
+
+/* dcooke.cpp */
+void report(dc_context *ctx, dc_diag_kind kind, const std::string &message,
+            size_t offset = DC_NO_OFFSET);
+void limitExceeded(dc_context *ctx, const char *what, size_t limit);
+void beginRun(dc_context *ctx);
+exitCode parseProgram(dc_context *ctx);
+
+/* lines.cpp */
+void where(dc_context *ctx, size_t offset, std::string *out);
+
+#endif
@@ -0,0 +1,276 @@
+/*
+=============================================================================
+Title : dcooke.cpp
+Description : C API entry points of libdcooke.
+Author : silrodri (R#11679913)
+Date : 10/19/2026
+Version : 2.0
+Usage : Built into libdcooke.a / libdcooke.so (see makefile)
+Notes : The drivers below are the loops that used to live in main().
+C++ Version : cpp (GCC) 4.8.5 20150623 (Red Hat 4.8.5-16)
+=============================================================================
+*/
+#include <cstring>
+#include <new>
+
+#include "context.h"
+#include "parser.h"
+
+/**
+ * @brief Record a diagnostic in the context, in the buffer of a cleared
+ *  one when there is one
+ */
+void report(dc_context *ctx, dc_diag_kind kind, const std::string &message, size_t offset)
+{
+    if (ctx->exit_code == LimitExceeded)
+        return;
+    if (ctx->limits.maxDiags && ctx->diags.size() >= ctx->limits.maxDiags)
+    {
+        limitExceeded(ctx, "diagnostic count", ctx->limits.maxDiags);
+        return;
+    }
+    dc_diag_rec d;
+    d.kind = kind;
+    if (!ctx->spare.empty())
+    {
+        d.message.swap(ctx->spare.back());
+        ctx->spare.pop_back();
+    }
+    d.message.assign(message);
+    d.offset = offset;
+    d.lexBefore = ctx->lexDiags;
+    ctx->diags.push_back(std::move(d));
+    // room for beginRun to hand every buffer back
+    size_t buffers = ctx->spare.size() + ctx->diags.size();
+    if (ctx->spare.capacity() < buffers)
+        ctx->spare.reserve(2 * buffers);
+}
+
+/**
+ * @brief Stop the run on a hardened-mode cap: record why, then drain the
+ *  input so the lexer only returns EOF and the parser unwinds
+ */
+void limitExceeded(dc_context *ctx, const char *what, size_t limit)
+{
+    if (ctx->exit_code == LimitExceeded)
+        return;
+    ctx->exit_code = LimitExceeded;
+    dc_diag_rec d;
+    d.kind = DC_DIAG_LIMIT;
+    d.message = std::string("Error - ") + what + " limit of " + std::to_string(limit) +
+                " exceeded";
+    where(ctx, ctx->tokenStart, &d.message);
+    d.offset = ctx->tokenStart;
+    d.lexBefore = ctx->lexDiags;
+    ctx->diags.push_back(d);
+    ctx->pos = ctx->src.size();
+}
+
+/**
+ * @brief Clear per-run results before a new dc_tokenize / dc_parse
+ */
+void beginRun(dc_context *ctx)
+{
+    ctx->tokens.clear();
+    ctx->lexemes.clear();
+    // a warm run reports its diagnostics without allocating
+    for (size_t i = 0; i < ctx->diags.size(); i++)
+    {
+        ctx->spare.push_back(std::string());
+        ctx->spare.back().swap(ctx->diags[i].message);
+    }
+    ctx->diags.clear();
+    symClear(&ctx->symbols);
+    ctx->ast.stmts.clear();
+    ctx->ast.exprs.clear();
+    ctx->ast.first = -1;
+    ctx->hits.clear();
+    ctx->closedForms = false;
+    ctx->tokenHash = 0;
+    memset(ctx->tokenDigest, 0, sizeof ctx->tokenDigest);
+    ctx->exit_code = ctx->shadowCode = NoError;
+    ctx->depth = ctx->parDepth = 0;
+    ctx->lexDiags = 0;
+    lexBegin(ctx);
+}
+
+const char *dc_version(void)
+{
+    return "2.0";
+}
+
+dc_context *dc_create(void)
+{
+    dc_context *ctx = new (std::nothrow) dc_context();
+    if (ctx != nullptr)
+    {
+        dc_set_limits(ctx, nullptr);
+        dc_reset(ctx);
+    }
+    return ctx;
+}
+
+void dc_destroy(dc_context *ctx)
+{
+    delete ctx;
+}
+
+void dc_reset(dc_context *ctx)
+{
+    ctx->src.clear();
+    ctx->pos = 0;
+    ctx->pull = nullptr;
+    ctx->pullUser = nullptr;
+    ctx->newlines.clear();
+    ctx->indexed = 0;
+    ctx->lexLen = 0;
+    ctx->lexeme[0] = 0;
+    ctx->nextToken = 0;
+    ctx->strNextToken = "";
+    ctx->tokens.clear();
+    ctx->lexemes.clear();
+    ctx->diags.clear();
+    symClear(&ctx->symbols);
+    ctx->ast.stmts.clear();
+    ctx->ast.exprs.clear();
+    ctx->ast.first = -1;
+    ctx->hits.clear();
+    ctx->closedForms = false;
+    ctx->exit_code = ctx->shadowCode = NoError;
+}
+
+void dc_set_limits(dc_context *ctx, const dc_limits *limits)
+{
+    if (limits == nullptr)
+        ctx->limits = dc_limits();
+    else
+        ctx->limits = *limits;
+}
+
+void dc_set_source(dc_context *ctx, dc_pull_fn pull_fn, void *user)
+{
+    ctx->pull = pull_fn;
+    ctx->pullUser = user;
+}
+
+int dc_feed(dc_context *ctx, const char *data, size_t len)
+{
+    try
+    {
+        ctx->src.insert(ctx->src.end(), data, data + len);
+    }
+    catch (const std::bad_alloc &)
+    {
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Lex every token of the input (the Project 1 main loop)
+ */
+exitCode dc_tokenize(dc_context *ctx)
+{
+    beginRun(ctx);
+    do
+    {
+        lex(ctx);
+    } while (ctx->nextToken != EOF);
+    return ctx->exit_code;
+}
+
+/**
+ * @brief Lex and parse the input statement by statement (the Project 2 main loop)
+ */
+exitCode parseProgram(dc_context *ctx)
+{
+    int tail = -1;
+
+    do
+    {
+        lex(ctx);
+        int s = statement(ctx);
+        // chain the statement lists of each pass into one program
+        if (s >= 0)
+        {
+            if (tail < 0)
+                ctx->ast.first = s;
+            else
+                ctx->ast.stmts[tail].next = s;
+            for (tail = s; ctx->ast.stmts[tail].next >= 0;)
+                tail = ctx->ast.stmts[tail].next;
+        }
+    } while (ctx->nextToken != EOF && ctx->exit_code != SyntaxError);
+    return ctx->exit_code;
+}
+
+exitCode dc_parse(dc_context *ctx)
+{
+    beginRun(ctx);
+    return parseProgram(ctx);
+}
+
+exitCode dc_result(const dc_context *ctx)
+{
+    return ctx->exit_code;
+}
+
+size_t dc_token_count(const dc_context *ctx)
+{
+    return ctx->tokens.size();
+}
+
+int dc_token_code(const dc_context *ctx, size_t i)
+{
+    return ctx->tokens[i].code;
+}
+
+const char *dc_token_lexeme(const dc_context *ctx, size_t i)
+{
+    return &ctx->lexemes[ctx->tokens[i].lexemeAt];
+}
+
+size_t dc_token_offset(const dc_context *ctx, size_t i)
+{
+    return ctx->tokens[i].offset;
+}
+
+long long dc_token_value(const dc_context *ctx, size_t i)
+{
+    return ctx->tokens[i].value;
+}
+
+int dc_token_symbol(const dc_context *ctx, size_t i)
+{
+    return ctx->tokens[i].symbol;
+}
+
+size_t dc_symbol_count(const dc_context *ctx)
+{
+    return ctx->symbols.syms.size();
+}
+
+const char *dc_symbol_name(const dc_context *ctx, int id)
+{
+    return &ctx->symbols.names[ctx->symbols.syms[id].nameAt];
+}
+
+size_t dc_diag_count(const dc_context *ctx)
+{
+    return ctx->diags.size();
+}
+
+dc_diag_kind dc_diag_kind_at(const dc_context *ctx, size_t i)
+{
+    return ctx->diags[i].kind;
+}
+
+const char *dc_diag_message(const dc_context *ctx, size_t i)
+{
+    return ctx->diags[i].message.c_str();
+}
+
+size_t dc_diag_offset(const dc_context *ctx, size_t i)
+{
+    return ctx->diags[i].offset;
+}
@@ -0,0 +1,361 @@
+/*
+=============================================================================
+Title : dcooke.h
+Description : Public C API of libdcooke, the embeddable DCooke lexer/parser.
+Author : silrodri (R#11679913)
+Date : 10/19/2026
+Version : 2.0
+Usage : #include "dcooke.h" and link with libdcooke.a or libdcooke.so
+Notes : Every call operates on a caller-owned dc_context, so independent
+        contexts may be used from different threads at the same time.
+C++ Version : cpp (GCC) 4.8.5 20150623 (Red Hat 4.8.5-16)
+=============================================================================
+*/
+#ifndef DCOOKE_H
+#define DCOOKE_H
+
+#include <stddef.h>
+#include <stdio.h> /* EOF is the end-of-input token code */
+
+#include "front.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Only the dc_* entry points are exported from libdcooke.so */
+#if defined(__GNUC__)
+#define DC_API __attribute__((visibility("default")))
+#else
+#define DC_API
+#endif
+
+/**
+ * @brief : Exit codes the program execution will see upon exit
+ */
+typedef enum exitCodes
+{
+    NoError,
+    SyntaxError,
+    MissingFile,
+    FileNotFound,
+    LimitExceeded,
+    RuntimeError
+} exitCode;
+
+/**
+ * @brief : Diagnostic kinds recorded in a context
+ */
+typedef enum dc_diag_kinds
+{
+    DC_DIAG_LEXICAL, /* problems found while scanning (e.g. lexeme too long) */
+    DC_DIAG_SYNTAX,  /* parser errors, formatted like the original error() */
+    DC_DIAG_WARNING, /* analysis warnings; they never change the exitCode */
+    DC_DIAG_LIMIT,   /* a dc_limits cap stopped the run (LimitExceeded) */
+    DC_DIAG_RUNTIME, /* dc_run stopped on an error (RuntimeError) */
+    DC_DIAG_NOTE     /* analysis findings that are not problems */
+} dc_diag_kind;
+
+/* Opaque lexer/parser state */
+typedef struct dc_context dc_context;
+
+/**
+ * @brief : Hard caps for validating untrusted input; 0 leaves a cap off.
+ *  The first cap reached stops the run with LimitExceeded and one
+ *  DC_DIAG_LIMIT diagnostic. Each check is a counter compare, so tokens,
+ *  AST nodes, diagnostics and stack depth stay bounded by the caps.
+ */
+typedef struct dc_limits
+{
+    size_t maxDepth;       /* nested do-bodies plus parentheses */
+    size_t maxTokenLength; /* characters in one lexeme */
+    size_t maxTokens;      /* tokens per run */
+    size_t maxDiags;       /* diagnostics per run */
+} dc_limits;
+
+/* Library version string, e.g. "2.0" */
+DC_API const char *dc_version(void);
+
+/* Create / destroy a context; dc_create returns NULL when out of memory */
+DC_API dc_context *dc_create(void);
+DC_API void dc_destroy(dc_context *ctx);
+
+/* Drop input, tokens and diagnostics so the context can serve a new request */
+DC_API void dc_reset(dc_context *ctx);
+
+/* Install caps for later runs; NULL removes every cap */
+DC_API void dc_set_limits(dc_context *ctx, const dc_limits *limits);
+
+/* Append len bytes of source text; returns 0 on success, -1 when out of memory */
+DC_API int dc_feed(dc_context *ctx, const char *data, size_t len);
+
+/* Scan the whole input into tokens (Project 1 behaviour) */
+DC_API exitCode dc_tokenize(dc_context *ctx);
+
+/* Scan and syntax check the whole input (Project 2 behaviour) */
+DC_API exitCode dc_parse(dc_context *ctx);
+
+/* dc_parse with the lexer on a second thread, feeding the parser through a
+ * lock-free token ring. Tokens, symbols and diagnostics come out as
+ * dc_parse leaves them. Runs with any dc_limits cap set use dc_parse */
+DC_API exitCode dc_parse_pipelined(dc_context *ctx);
+
+/* After a successful dc_parse, warn (DC_DIAG_WARNING) about variables that
+ * may be read before any assignment reaches them; returns the warning count */
+DC_API int dc_warn_uninit(dc_context *ctx);
+
+/* After a successful dc_parse, run an interval/congruence abstract
+ * interpretation. Loops proven never to terminate get a DC_DIAG_WARNING,
+ * loops proven to terminate a DC_DIAG_NOTE, and every variable a
+ * DC_DIAG_NOTE with the range of values it can hold. The work is capped,
+ * so very deep nests or huge programs stop early with a note instead.
+ * Returns the number of loops proven infinite */
+DC_API int dc_analyze(dc_context *ctx);
+
+/* After a successful dc_parse, look for statements of do-while bodies that
+ * can run at the same time: a run of them where none reads a variable an
+ * earlier one assigns, with no read() and no division that may fail, is
+ * rewritten in place into par { ... }, so dc_run forks it. Only runs where
+ * at least two statements contain loops are worth a fork. Every do-while
+ * gets a DC_DIAG_NOTE saying what was done and why. Returns the number of
+ * par statements made */
+DC_API int dc_parallelize(dc_context *ctx);
+
+/* After a successful dc_parse, find the do-while loops whose bodies are
+ * only assignments of affine values: sums of the variables the loop changes
+ * times values it does not. Later dc_run calls (unprofiled) solve such a
+ * loop's trip count on entry and compute its final values in O(log n)
+ * instead of stepping through it; when the count cannot be solved exactly
+ * the loop is stepped, so results never change. Every do-while gets a
+ * DC_DIAG_NOTE with its induction variables or what keeps it stepped.
+ * Returns the number of loops with a closed form */
+DC_API int dc_close_loops(dc_context *ctx);
+
+/* Input and output of dc_run: read_fn stores the next value and returns 0,
+ * or -1 when input is exhausted; write_fn receives each write(V) value */
+typedef int (*dc_read_fn)(void *user, long long *value);
+typedef void (*dc_write_fn)(void *user, long long value);
+
+/* After a successful dc_parse, execute the program. Variables start at 0,
+ * arithmetic wraps, and division by zero or reading past the input ends
+ * the run with RuntimeError. The branches of par { s1; s2; ... } run on a
+ * work-stealing pool of workers threads (0 = one per CPU). Each branch
+ * starts on a snapshot of the variables. At the join, the variables a
+ * branch assigned are copied back in branch order, so a later branch wins,
+ * and write() output comes out in the same order. Both callbacks are only
+ * invoked on the calling thread; either may be NULL */
+DC_API exitCode dc_run(dc_context *ctx, unsigned workers, dc_read_fn read_fn,
+                       dc_write_fn write_fn, void *user);
+
+/* Exact arithmetic for dc_run. While on, + - * / and comparisons never
+ * wrap: a value that leaves the long long range is kept as a bignum, and
+ * write(V) of such a value calls text_fn(user, digits) with its decimal
+ * digits (a leading '-' when negative) instead of write_fn. Values that
+ * fit still go to write_fn, and LLONG_MIN itself goes to text_fn. The
+ * cost is an overflow check per operation until a value gets big. Closed
+ * forms are not used while it is on; dc_run_batch, dc_emit_c and fleets
+ * keep wrapping */
+typedef void (*dc_write_text_fn)(void *user, const char *digits);
+DC_API void dc_set_exact(dc_context *ctx, int on, dc_write_text_fn text_fn);
+
+/* Batched dc_run: execute the program once per row of an input table, many
+ * rows at a time in SIMD lanes. inputs is column-major: the k-th read() of
+ * row r takes inputs[k * rows + r], for k < counts[r] (or k < columns when
+ * counts is NULL). The k-th write(V) of row r calls write_fn(user, r, value)
+ * and the writes of each row arrive in order. status (may be NULL) receives
+ * NoError or RuntimeError per row. Returns RuntimeError, with one
+ * DC_DIAG_RUNTIME summary, when any row failed */
+typedef void (*dc_batch_write_fn)(void *user, size_t row, long long value);
+DC_API exitCode dc_run_batch(dc_context *ctx, const long long *inputs, size_t rows,
+                             size_t columns, const size_t *counts,
+                             dc_batch_write_fn write_fn, void *user, exitCode *status);
+
+/* After a successful dc_parse, write the program to out as a standalone C
+ * source file (also valid C++). Compiled and run, it behaves like dc_run
+ * with read() on stdin and write() on stdout, including the runtime error
+ * messages and the RuntimeError exit status. par branches run one after
+ * another, so a runtime error inside a par stops at the first failing
+ * branch after the output of the ones up to it, as with dc_run. Returns 0,
+ * or -1 when there is no valid program or out fails */
+DC_API int dc_emit_c(dc_context *ctx, FILE *out);
+
+/* Scan the whole input and write it to out in canonical layout: one
+ * statement per line, blocks indented by four spaces, single spaces
+ * between tokens. Only blanks change, so the output has the same tokens
+ * and formats to itself. Input that does not lex or parse is laid out all
+ * the same. Tokens are only scanned, so none are recorded and no
+ * diagnostics are raised. out may be NULL to only compute the hash.
+ * Returns 0, or -1 when out fails */
+DC_API int dc_format(dc_context *ctx, FILE *out);
+
+/* 64-bit hash of the token list of the last dc_format (0 after any other
+ * run). Sources that differ only in blanks hash alike, so it can key a
+ * cache of results that do not depend on line and column numbers */
+DC_API unsigned long long dc_token_hash(const dc_context *ctx);
+
+/* SHA-256 of the same token list into digest[32] (zeros after any other
+ * run). Two token lists with different digests cannot be found, so unlike
+ * dc_token_hash it can be trusted as the only check that two sources
+ * have the same tokens */
+DC_API void dc_token_digest(const dc_context *ctx, unsigned char digest[32]);
+
+/* Statement profiling of dc_run. While on, each dc_run counts how often
+ * every statement starts and how often every do-while tests its condition,
+ * adding to the counts of the runs before it; par branches count into the
+ * same totals. Turning it on clears the counts, and so does a new parse.
+ * The cost is one counter increment per statement run. dc_run_batch is
+ * not profiled */
+DC_API void dc_set_profiling(dc_context *ctx, int on);
+
+/* Write the counts as a flat report, the statements with the most work
+ * first (a do-while's own work is its condition tests). Returns 0, or -1
+ * when nothing has been profiled or out fails */
+DC_API int dc_profile_report(dc_context *ctx, FILE *out);
+
+/* Write the counts as folded stacks for flame graph tools, one line per
+ * statement with work: the enclosing do/par frames, the statement, and
+ * its count, as in "do@3:1;do@4:5;x=@5:9 120" (frames are kind@line:col).
+ * Returns 0, or -1 when nothing has been profiled or out fails */
+DC_API int dc_profile_folded(dc_context *ctx, FILE *out);
+
+/* Many running programs on one thread. Every instance is a stackless
+ * coroutine: a program counter, its variables and a fixed-size operand
+ * stack, a few hundred bytes for a small program. read() with no value
+ * fed suspends the instance, write(V) hands V to write_fn and yields, and
+ * each turn an instance gets ends after quantum instructions, so a busy
+ * loop cannot starve the others. Semantics are those of dc_run, with par
+ * branches run one after another (see dc_emit_c). Callbacks run inside
+ * dc_fleet_run and may call dc_fleet_spawn, dc_fleet_feed and
+ * dc_fleet_end_input */
+typedef struct dc_fleet dc_fleet;
+typedef void (*dc_fleet_write_fn)(void *user, long id, long long value);
+typedef void (*dc_fleet_wait_fn)(void *user, long id); /* id waits in read() */
+typedef void (*dc_fleet_exit_fn)(void *user, long id, exitCode code, const char *message);
+
+typedef struct dc_fleet_io
+{
+    dc_fleet_write_fn write_fn; /* each may be NULL */
+    dc_fleet_wait_fn wait_fn;
+    dc_fleet_exit_fn exit_fn; /* NoError, RuntimeError, or LimitExceeded */
+    void *user;
+} dc_fleet_io;
+
+/* quantum: instructions per turn (0 = 10000). limit: instructions an
+ * instance may run in all, 0 for no limit; past it the instance exits with
+ * LimitExceeded */
+DC_API dc_fleet *dc_fleet_create(const dc_fleet_io *io, unsigned long long quantum,
+                                 unsigned long long limit);
+DC_API void dc_fleet_destroy(dc_fleet *fleet);
+
+/* Start an instance of the program of ctx, which must hold a successful
+ * dc_parse and must not be parsed again while the fleet runs it. The
+ * program is compiled once per context. Returns the instance id, or -1.
+ * Ids of exited instances are reused */
+DC_API long dc_fleet_spawn(dc_fleet *fleet, dc_context *ctx);
+
+/* Queue a value for the read() calls of instance id. After
+ * dc_fleet_end_input, a read() with nothing queued is a runtime error.
+ * Both return 0, or -1 for an unknown id */
+DC_API int dc_fleet_feed(dc_fleet *fleet, long id, long long value);
+DC_API int dc_fleet_end_input(dc_fleet *fleet, long id);
+
+/* Run instances until every one is waiting for input or has exited.
+ * Returns the number still waiting */
+DC_API size_t dc_fleet_run(dc_fleet *fleet);
+
+/* Result of the last dc_tokenize / dc_parse / dc_run call */
+DC_API exitCode dc_result(const dc_context *ctx);
+
+/* Tokens recorded by the last run; EOF is not recorded */
+DC_API size_t dc_token_count(const dc_context *ctx);
+DC_API int dc_token_code(const dc_context *ctx, size_t i);
+DC_API const char *dc_token_lexeme(const dc_context *ctx, size_t i);
+DC_API size_t dc_token_offset(const dc_context *ctx, size_t i);
+
+/* Value of an INT_LIT token decoded while scanning (0 for other tokens);
+ * literals that do not fit saturate to LLONG_MAX with a DC_DIAG_LEXICAL */
+DC_API long long dc_token_value(const dc_context *ctx, size_t i);
+
+/* Dense symbol ID of an IDENT token (-1 for other tokens). IDs run from 0 to
+ * dc_symbol_count() - 1 in order of first appearance, so per-variable data
+ * can live in plain arrays indexed by ID */
+DC_API int dc_token_symbol(const dc_context *ctx, size_t i);
+DC_API size_t dc_symbol_count(const dc_context *ctx);
+DC_API const char *dc_symbol_name(const dc_context *ctx, int id);
+
+/* Directive name of a token code, e.g. "ASSIGN_OP"; "UNKNOWN" if unmapped */
+DC_API const char *dc_token_name(int code);
+
+/* Diagnostics recorded by the last run, in the order they were raised */
+DC_API size_t dc_diag_count(const dc_context *ctx);
+DC_API dc_diag_kind dc_diag_kind_at(const dc_context *ctx, size_t i);
+DC_API const char *dc_diag_message(const dc_context *ctx, size_t i);
+
+/* Source byte offset a diagnostic refers to, or DC_NO_OFFSET */
+#define DC_NO_OFFSET ((size_t)-1)
+DC_API size_t dc_diag_offset(const dc_context *ctx, size_t i);
+
+/* Map a byte offset of the input to a 1-based line and column (in bytes).
+ * The newline index is built on the first call, so runs that never ask pay
+ * nothing. Returns -1 when offset is past the end of the input */
+DC_API int dc_locate(dc_context *ctx, size_t offset, size_t *line, size_t *column);
+
+/* Pull input while scanning: once the fed bytes run out, the lexer calls
+ * pull_fn, which should dc_feed() more input and return 0, or return -1 at
+ * the end. Every chunk but the last must end on a blank or between two
+ * bytes no token holds together, so that no token is split between chunks.
+ * dc_reset() removes the source */
+typedef int (*dc_pull_fn)(void *user, dc_context *ctx);
+DC_API void dc_set_source(dc_context *ctx, dc_pull_fn pull_fn, void *user);
+
+/* A file read on a background thread into a ring of buffers. Input that
+ * starts with the gzip or zstd magic number is decompressed on the way, so
+ * reading and decompression overlap with parsing. dc_stream_open returns
+ * NULL with errno set when the file cannot be opened */
+typedef struct dc_stream dc_stream;
+DC_API dc_stream *dc_stream_open(const char *path);
+
+/* Like dc_stream_open, but the whole file is read and decompressed on the
+ * calling thread before it returns, with no reader thread */
+DC_API dc_stream *dc_stream_load(const char *path);
+
+/* A dc_pull_fn: dc_set_source(ctx, dc_stream_pull, stream) */
+DC_API int dc_stream_pull(void *stream, dc_context *ctx);
+
+/* Bytes handed to the lexer so far, after decompression */
+DC_API size_t dc_stream_bytes(const dc_stream *stream);
+
+/* Why the input ended early (bad or truncated data, read error), or NULL */
+DC_API const char *dc_stream_error(dc_stream *stream);
+DC_API void dc_stream_close(dc_stream *stream);
+
+/**
+ * @brief : How dc_ingest loads files
+ */
+typedef enum dc_ingest_backends
+{
+    DC_INGEST_AUTO,   /* io_uring when available, else DC_INGEST_THREADS */
+    DC_INGEST_URING,  /* Linux io_uring only; dc_ingest fails without it */
+    DC_INGEST_THREADS /* each worker does blocking fopen/fread/fclose */
+} dc_ingest_backend;
+
+/* Called on a worker thread once per path: index is the position in paths,
+ * data/len the file contents (valid only during the call) and err an errno
+ * value, 0 on success. worker is in [0, workers) so callers can keep one
+ * dc_context per worker. */
+typedef void (*dc_ingest_fn)(void *user, unsigned worker, size_t index,
+                             const char *data, size_t len, int err);
+
+/* Load count files in bulk and hand each to fn on a pool of workers (0 = one
+ * per CPU). Only a few files per worker are loaded ahead of fn, so memory
+ * stays bounded when fn is slower than the disk. Returns the backend used,
+ * or -1 if DC_INGEST_URING is unavailable */
+DC_API int dc_ingest(const char *const *paths, size_t count, unsigned workers,
+                     dc_ingest_backend backend, dc_ingest_fn fn, void *user);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
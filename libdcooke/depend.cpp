@@ -0,0 +1,403 @@
+/*
+=============================================================================
+Title : depend.cpp
+Description : Dependence analysis of do-while bodies; independent loop
+              statements are rewritten into par (dc_parallelize).
+Author : silrodri (R#11679913)
+Date : 10/19/2026
+Version : 2.0
+Usage : Built into libdcooke; run after a successful dc_parse()
+Notes : The statements of a body are split into runs where no statement
+        reads a variable an earlier one in the run assigns. Such a run can
+        become par { ... } with its statements as branches in their
+        original order: par hands every branch the values from before the
+        par (what the earlier statements did not change), copies back in
+        branch order (the later assignment wins, as in sequence) and emits
+        write() output in branch order. read() and divisions that may fail
+        end a run, since par forbids read() and a par that fails drops the
+        output of the branches after the failed one, which in sequence
+        could have come before the error. A fork costs far more than a few
+        assignments, so a run only becomes a par when at least two of its
+        statements contain a loop. Each body gets a note saying what was done and why.
+C++ Version : cpp (GCC) 4.8.5 20150623 (Red Hat 4.8.5-16)
+=============================================================================
+*/
+#include <algorithm>
+#include <map>
+
+#include "cfg.h"
+#include "context.h"
+
+#define NO_OFFSET ((size_t)-1)
+
+/**
+ * @brief : What one body statement does, nested statements included
+ */
+struct dc_access
+{
+    std::vector<int> reads, writes; // sorted symbols
+    size_t readAt;                  // a read() in it, or NO_OFFSET
+    size_t divideAt;                // a division that may fail, or NO_OFFSET
+    bool loops;                     // contains a do-while
+    bool output;                    // contains a write()
+};
+
+static void exprAccess(const dc_ast *ast, int e, dc_access *acc)
+{
+    std::vector<int> work(1, e);
+    while (e >= 0 && !work.empty())
+    {
+        const dc_expr &ex = ast->exprs[work.back()];
+        work.pop_back();
+        if (ex.op == IDENT || ex.op == INC_OP || ex.op == DEC_OP)
+            acc->reads.push_back(ex.symbol);
+        if (ex.op == INC_OP || ex.op == DEC_OP)
+            acc->writes.push_back(ex.symbol);
+        if (ex.op == DIV_OP && acc->divideAt == NO_OFFSET)
+        {
+            const dc_expr &by = ast->exprs[ex.right];
+            if (by.op != INT_LIT || by.value == 0)
+                acc->divideAt = ex.offset;
+        }
+        if (ex.left >= 0)
+        {
+            work.push_back(ex.left);
+            work.push_back(ex.right);
+        }
+    }
+}
+
+static void sortUnique(std::vector<int> *v)
+{
+    std::sort(v->begin(), v->end());
+    v->erase(std::unique(v->begin(), v->end()), v->end());
+}
+
+/**
+ * @brief What every statement from first on does, each body merged into
+ *  the statement that holds it, so no statement is looked at twice
+ */
+static void accessAll(const dc_ast *ast, int first, std::vector<dc_access> *acc)
+{
+    std::vector<int> order, work(1, first);
+    acc->assign(ast->stmts.size(), dc_access());
+    // every statement lands in order before the statements of its body
+    while (!work.empty())
+    {
+        int s = work.back();
+        work.pop_back();
+        for (; s >= 0; s = ast->stmts[s].next)
+        {
+            order.push_back(s);
+            if (ast->stmts[s].body >= 0)
+                work.push_back(ast->stmts[s].body);
+        }
+    }
+    for (size_t i = order.size(); i > 0; i--)
+    {
+        const dc_stmt &st = ast->stmts[order[i - 1]];
+        dc_access &a = (*acc)[order[i - 1]];
+        a.readAt = st.kind == KEY_READ ? st.offset : NO_OFFSET;
+        a.divideAt = NO_OFFSET;
+        a.loops = st.kind == KEY_DO;
+        a.output = st.kind == KEY_WRITE;
+        if (st.kind == KEY_WRITE)
+            a.reads.push_back(st.symbol);
+        if (st.kind == ASSIGN_OP || st.kind == KEY_READ)
+            a.writes.push_back(st.symbol);
+        exprAccess(ast, st.expr, &a);
+        exprAccess(ast, st.cond, &a);
+        for (int b = st.body; b >= 0; b = ast->stmts[b].next)
+        {
+            const dc_access &in = (*acc)[b];
+            if (a.readAt == NO_OFFSET)
+                a.readAt = in.readAt;
+            if (a.divideAt == NO_OFFSET)
+                a.divideAt = in.divideAt;
+            a.loops = a.loops || in.loops;
+            a.output = a.output || in.output;
+            a.reads.insert(a.reads.end(), in.reads.begin(), in.reads.end());
+            a.writes.insert(a.writes.end(), in.writes.begin(), in.writes.end());
+        }
+        sortUnique(&a.reads);
+        sortUnique(&a.writes);
+    }
+}
+
+/**
+ * @brief " at line L, column C" of an offset
+ */
+static std::string placeOf(dc_context *ctx, size_t offset)
+{
+    std::string at;
+    where(ctx, offset, &at);
+    return at;
+}
+
+static int root(std::vector<int> *group, int i)
+{
+    while ((*group)[i] != i)
+        i = (*group)[i] = (*group)[(*group)[i]];
+    return i;
+}
+
+/**
+ * @brief : Grouping of the statements of one run
+ */
+struct dc_grouping
+{
+    std::vector<int> group;  // union-find parent, per statement of the body
+    std::vector<char> loops; // per root: the group contains a do-while
+    std::string why;         // the first dependence joining two looping groups
+};
+
+static void join(dc_grouping *g, int i, int j, const std::string &why)
+{
+    i = root(&g->group, i);
+    j = root(&g->group, j);
+    if (i == j)
+        return;
+    if (g->loops[i] && g->loops[j] && g->why.empty())
+        g->why = why;
+    g->group[j] = i;
+    g->loops[i] = g->loops[i] || g->loops[j];
+}
+
+/**
+ * @brief Statements body[from, to) as a branch: the statement itself, or
+ *  do { ... } while (0) around several
+ */
+static int branchOf(dc_ast *ast, const std::vector<int> &stmts)
+{
+    for (size_t i = 0; i + 1 < stmts.size(); i++)
+        ast->stmts[stmts[i]].next = stmts[i + 1];
+    ast->stmts[stmts.back()].next = -1;
+    if (stmts.size() == 1)
+        return stmts[0];
+
+    dc_expr zero = dc_expr();
+    zero.op = INT_LIT;
+    zero.left = zero.right = zero.symbol = -1;
+    zero.offset = ast->stmts[stmts[0]].offset;
+    ast->exprs.push_back(zero);
+    dc_stmt once = ast->stmts[stmts[0]];
+    once.kind = KEY_DO;
+    once.symbol = once.expr = -1;
+    once.body = stmts[0];
+    once.cond = (int)ast->exprs.size() - 1;
+    ast->stmts.push_back(once);
+    return (int)ast->stmts.size() - 1;
+}
+
+/**
+ * @brief Decide on the body of do-while s, rewriting runs into par; all is
+ *  the access of every statement the parser made
+ */
+static void planLoop(dc_context *ctx, int s, const std::vector<dc_access> &all,
+                     std::vector<dc_diag_rec> *notes, int *made)
+{
+    dc_ast *ast = &ctx->ast;
+    std::vector<int> body;
+    std::vector<dc_access> acc;
+    for (int b = ast->stmts[s].body; b >= 0; b = ast->stmts[b].next)
+    {
+        body.push_back(b);
+        acc.push_back(all[b]);
+    }
+
+    // runs end at read() and at divisions that may fail; inside a run a
+    // statement joins the group of the last statement to assign what it
+    // reads or assigns, and of the last one to write() when it does
+    dc_grouping g;
+    std::vector<size_t> starts;
+    std::map<int, int> lastWriter; // symbol (-1: output) to statement
+    std::string barrier;
+    size_t loops = 0, loopsBefore = 0;
+    g.loops.assign(body.size(), 0);
+    for (size_t i = 0; i < body.size(); i++)
+    {
+        g.group.push_back((int)i);
+        g.loops[i] = acc[i].loops;
+        loops += acc[i].loops;
+    }
+    for (size_t i = 0; i < body.size(); i++)
+    {
+        const dc_access &a = acc[i];
+        std::string why;
+        if (a.readAt != NO_OFFSET)
+            why = "read()" + placeOf(ctx, a.readAt) + " must keep its place in the input";
+        else if (a.divideAt != NO_OFFSET)
+            why = "the division" + placeOf(ctx, a.divideAt) +
+                  " may fail, and what runs before the error must not change";
+        if (i == 0 || !why.empty() || acc[i - 1].readAt != NO_OFFSET ||
+            acc[i - 1].divideAt != NO_OFFSET)
+        {
+            if (!why.empty() && barrier.empty() && loopsBefore > 0 && loops > loopsBefore)
+                barrier = why;
+            starts.push_back(i);
+            lastWriter.clear();
+        }
+        loopsBefore += a.loops;
+
+        std::string here = placeOf(ctx, ast->stmts[body[i]].offset);
+        std::map<int, int>::iterator w;
+        for (size_t r = 0; r < a.reads.size(); r++)
+            if ((w = lastWriter.find(a.reads[r])) != lastWriter.end())
+                join(&g, w->second, (int)i,
+                     std::string("the statement") + here + " reads '" +
+                         dc_symbol_name(ctx, a.reads[r]) + "', assigned" +
+                         placeOf(ctx, ast->stmts[body[w->second]].offset));
+        for (size_t r = 0; r < a.writes.size(); r++)
+        {
+            if ((w = lastWriter.find(a.writes[r])) != lastWriter.end())
+                join(&g, w->second, (int)i,
+                     std::string("the statements") +
+                         placeOf(ctx, ast->stmts[body[w->second]].offset) + " and" +
+                         here.substr(3) + " both assign '" +
+                         dc_symbol_name(ctx, a.writes[r]) + "'");
+            lastWriter[a.writes[r]] = (int)i;
+        }
+        if (a.output)
+        {
+            if ((w = lastWriter.find(-1)) != lastWriter.end())
+                join(&g, w->second, (int)i,
+                     std::string("the statements") +
+                         placeOf(ctx, ast->stmts[body[w->second]].offset) + " and" +
+                         here.substr(3) + " both write() output");
+            lastWriter[-1] = (int)i;
+        }
+    }
+    starts.push_back(body.size());
+
+    std::string at;
+    where(ctx, ast->stmts[s].offset, &at);
+    std::vector<int> slot(body.size(), -1); // per root: its branch
+    bool any = false;
+    for (size_t r = 0; r + 1 < starts.size(); r++)
+    {
+        // the groups of the run, in the order of their first statements
+        size_t from = starts[r], to = starts[r + 1], heavy = 0;
+        std::vector<std::vector<int> > members;
+        for (size_t i = from; i < to; i++)
+        {
+            int k = root(&g.group, (int)i);
+            if (slot[k] < 0)
+            {
+                slot[k] = (int)members.size();
+                members.push_back(std::vector<int>());
+                heavy += g.loops[k];
+            }
+            members[slot[k]].push_back(body[i]);
+        }
+        if (heavy < 2)
+            continue;
+
+        // par { branch; ... } in place of the run
+        std::string lines;
+        for (size_t m = 0; m < members.size(); m++)
+        {
+            lines += m ? ", {" : "{";
+            for (size_t i = 0; i < members[m].size(); i++)
+            {
+                size_t line = 0;
+                dc_locate(ctx, ast->stmts[members[m][i]].offset, &line, nullptr);
+                lines += (i ? ", " : "") + std::to_string(line);
+            }
+            lines += "}";
+        }
+        int after = ast->stmts[body[to - 1]].next;
+        dc_stmt par = ast->stmts[body[from]];
+        par.kind = KEY_PAR;
+        par.symbol = par.expr = par.cond = -1;
+        par.body = -1;
+        int tail = -1;
+        for (size_t m = 0; m < members.size(); m++)
+        {
+            int b = branchOf(ast, members[m]);
+            if (tail < 0)
+                par.body = b;
+            else
+                ast->stmts[tail].next = b;
+            tail = b;
+        }
+        ast->stmts[tail].next = -1;
+        par.next = after;
+        ast->stmts.push_back(par);
+        int p = (int)ast->stmts.size() - 1;
+        if (from == 0)
+            ast->stmts[s].body = p;
+        else
+            ast->stmts[body[from - 1]].next = p;
+
+        dc_diag_rec d;
+        d.kind = DC_DIAG_NOTE;
+        d.offset = ast->stmts[s].offset;
+        d.lexBefore = 0;
+        d.message = "note: do-while" + at + ": lines " + lines + " run as " +
+                    std::to_string(members.size()) + " par branches, " +
+                    std::to_string(heavy) + " of them with loops; no branch reads or "
+                    "assigns what another assigns";
+        notes->push_back(d);
+        (*made)++;
+        any = true;
+    }
+    if (!any)
+    {
+        dc_diag_rec d;
+        d.kind = DC_DIAG_NOTE;
+        d.offset = ast->stmts[s].offset;
+        d.lexBefore = 0;
+        d.message = "note: do-while" + at + " stays sequential: ";
+        if (loops < 2)
+            d.message += loops ? "only one statement of its body contains a loop"
+                               : "no statement of its body contains a loop";
+        else
+            d.message += !barrier.empty() ? barrier : g.why;
+        notes->push_back(d);
+    }
+}
+
+/**
+ * @brief Plan every loop from statement s on, outer loops first, so inner
+ *  loops are also found inside the par made around them
+ */
+static void planList(dc_context *ctx, int s, const std::vector<dc_access> &all,
+                     std::vector<dc_diag_rec> *notes, int *made)
+{
+    std::vector<int> work(1, s); // statements still to visit, with what follows them
+    while (!work.empty())
+    {
+        s = work.back();
+        work.pop_back();
+        if (s < 0)
+            continue;
+        int kind = ctx->ast.stmts[s].kind, cond = ctx->ast.stmts[s].cond;
+        work.push_back(ctx->ast.stmts[s].next);
+        // do { ... } while (0) runs once, as do the branches made here
+        if (kind == KEY_DO && !(ctx->ast.exprs[cond].op == INT_LIT &&
+                                ctx->ast.exprs[cond].value == 0))
+            planLoop(ctx, s, all, notes, made);
+        if (kind == KEY_DO || kind == KEY_PAR)
+            work.push_back(ctx->ast.stmts[s].body);
+    }
+}
+
+static bool byOffset(const dc_diag_rec &a, const dc_diag_rec &b)
+{
+    return a.offset < b.offset;
+}
+
+int dc_parallelize(dc_context *ctx)
+{
+    if (ctx->exit_code != NoError)
+        return 0;
+    std::vector<dc_diag_rec> notes;
+    std::vector<dc_access> all;
+    int made = 0;
+    accessAll(&ctx->ast, ctx->ast.first, &all);
+    planList(ctx, ctx->ast.first, all, &notes, &made);
+    std::stable_sort(notes.begin(), notes.end(), byOffset);
+    for (size_t i = 0; i < notes.size(); i++)
+        report(ctx, notes[i].kind, notes[i].message, notes[i].offset);
+    return made;
+}
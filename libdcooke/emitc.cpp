@@ -0,0 +1,464 @@
+/*
+=============================================================================
+Title : emitc.cpp
+Description : C backend: lowers a validated program to C source (dc_emit_c).
+Author : silrodri (R#11679913)
+Date : 10/19/2026
+Version : 2.0
+Usage : Built into libdcooke; see dc_emit_c() in dcooke.h
+Notes : The output is one main() that behaves like dc_run with stdin and
+        stdout callbacks: the same wrap-around arithmetic, runtime error
+        messages and exit code. Every variable is a local, so the C
+        compiler can keep it in a register. Operands are computed into
+        temporaries in the order the interpreter evaluates them, which
+        keeps the first runtime error the same. A par runs its branches one
+        after another, each on local copies of the variables it assigns,
+        and copies them back in branch order; that is the join rule of
+        dc_run without the threads. The code is both C99 and C++.
+C++ Version : cpp (GCC) 4.8.5 20150623 (Red Hat 4.8.5-16)
+=============================================================================
+*/
+#include <algorithm>
+#include <cstring>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "cfg.h"
+#include "context.h"
+
+// runtime support copied into every generated file
+static const char *const prelude =
+    "#include <stdio.h>\n"
+    "#include <stdlib.h>\n"
+    "\n"
+    "/* wrap-around arithmetic, done unsigned to stay defined */\n"
+    "#define DC_ADD(a, b) ((long long)((unsigned long long)(a) + (unsigned long long)(b)))\n"
+    "#define DC_SUB(a, b) ((long long)((unsigned long long)(a) - (unsigned long long)(b)))\n"
+    "#define DC_MUL(a, b) ((long long)((unsigned long long)(a) * (unsigned long long)(b)))\n"
+    "\n"
+    "/* write() inside par is held until the outermost join */\n"
+    "static long long *dc_held;\n"
+    "static size_t dc_nheld, dc_capheld;\n"
+    "\n"
+    "static void dc_hold(long long v)\n"
+    "{\n"
+    "    if (dc_nheld == dc_capheld)\n"
+    "    {\n"
+    "        dc_capheld = dc_capheld ? 2 * dc_capheld : 64;\n"
+    "        dc_held = (long long *)realloc(dc_held, dc_capheld * sizeof *dc_held);\n"
+    "        if (dc_held == NULL)\n"
+    "            abort();\n"
+    "    }\n"
+    "    dc_held[dc_nheld++] = v;\n"
+    "}\n"
+    "\n"
+    "static void dc_release(void)\n"
+    "{\n"
+    "    size_t i;\n"
+    "    for (i = 0; i < dc_nheld; i++)\n"
+    "        printf(\"%lld\\n\", dc_held[i]);\n"
+    "    dc_nheld = 0;\n"
+    "}\n"
+    "\n"
+    "static long long dc_div(long long a, long long b, const char *at)\n"
+    "{\n"
+    "    if (b == 0)\n"
+    "    {\n"
+    "        dc_release();\n"
+    "        fflush(stdout);\n"
+    "        fprintf(stderr, \"Error - division by zero%s\\n\", at);\n"
+    "        exit(5);\n"
+    "    }\n"
+    "    if (b == -1)\n"
+    "        return DC_SUB(0, a); /* LLONG_MIN / -1 wraps to itself */\n"
+    "    return a / b;\n"
+    "}\n"
+    "\n"
+    "static long long dc_read(const char *name, const char *at)\n"
+    "{\n"
+    "    long long v;\n"
+    "    if (scanf(\"%lld\", &v) != 1)\n"
+    "    {\n"
+    "        fflush(stdout);\n"
+    "        fprintf(stderr, \"Error - read(%s)%s: no more input\\n\", name, at);\n"
+    "        exit(5);\n"
+    "    }\n"
+    "    return v;\n"
+    "}\n";
+
+/**
+ * @brief : A variable one par branch assigns, and the names it goes by
+ */
+struct dc_copy
+{
+    int symbol;
+    std::string outer; // outside the branch
+    std::string copy;  // inside it
+};
+
+/**
+ * @brief : Work left for emitList, innermost last
+ *  EMIT_LIST   : the statements from s on
+ *  EMIT_STMT   : statement s alone (a par branch)
+ *  EMIT_DO_END : the condition and end of do-while s, its flag in text
+ *  EMIT_BRANCH : the start of branch k of the innermost par
+ *  EMIT_BRANCH_END : the end of branch k of the innermost par
+ *  EMIT_JOIN   : the join of the innermost par
+ */
+enum dc_emit_work
+{
+    EMIT_LIST,
+    EMIT_STMT,
+    EMIT_DO_END,
+    EMIT_BRANCH,
+    EMIT_BRANCH_END,
+    EMIT_JOIN
+};
+
+struct dc_emit_item
+{
+    dc_emit_work what;
+    int s; // statement, or branch number
+    std::string text;
+};
+
+/**
+ * @brief : State of one dc_emit_c call
+ */
+struct dc_emitter
+{
+    dc_context *ctx;
+    const dc_ast *ast;
+    std::string out;
+    std::vector<std::string> names; // C name each symbol currently maps to
+    int temps;                      // temporaries and copies named so far
+    int depth;                      // indentation, in blocks
+    int parDepth;
+    std::vector<dc_emit_item> work;
+    std::vector<std::vector<std::vector<dc_copy> > > pars; // per open par, per branch
+};
+
+static void line(dc_emitter *em, const std::string &text)
+{
+    em->out.append(4 * em->depth, ' ');
+    em->out += text;
+    em->out += '\n';
+}
+
+static std::string fresh(dc_emitter *em, const char *prefix)
+{
+    return prefix + std::to_string(em->temps++);
+}
+
+/**
+ * @brief The C string literal " at line L, column C" of an offset, for the
+ *  runtime error messages
+ */
+static std::string placeOf(dc_emitter *em, size_t offset)
+{
+    std::string at;
+    where(em->ctx, offset, &at);
+    return "\"" + at + "\"";
+}
+
+static void push(dc_emitter *em, dc_emit_work what, int s, const std::string &text = "")
+{
+    dc_emit_item it;
+    it.what = what;
+    it.s = s;
+    it.text = text;
+    em->work.push_back(it);
+}
+
+/**
+ * @brief Lower an expression; returns the C operand holding its value.
+ *  Postfix operators are collected for the end of the statement
+ */
+static std::string emitExpr(dc_emitter *em, int e, std::vector<int> *postfix)
+{
+    // (node, operands done); operands are lowered left first and leave
+    // their C operands on values
+    std::vector<std::pair<int, bool> > work(1, std::make_pair(e, false));
+    std::vector<std::string> values;
+    while (!work.empty())
+    {
+        std::pair<int, bool> top = work.back();
+        work.pop_back();
+        const dc_expr &ex = em->ast->exprs[top.first];
+        switch (ex.op)
+        {
+        case INT_LIT:
+            values.push_back(std::to_string(ex.value) + "LL");
+            continue;
+        case IDENT:
+            values.push_back(em->names[ex.symbol]);
+            continue;
+        case INC_OP:
+        case DEC_OP:
+            postfix->push_back(top.first);
+            values.push_back(em->names[ex.symbol]);
+            continue;
+        }
+        if (!top.second)
+        {
+            work.push_back(std::make_pair(top.first, true));
+            work.push_back(std::make_pair(ex.right, false));
+            work.push_back(std::make_pair(ex.left, false));
+            continue;
+        }
+
+        std::string b = values.back();
+        values.pop_back();
+        std::string a = values.back();
+        values.pop_back();
+        std::string value;
+        switch (ex.op)
+        {
+        case ADD_OP:
+            value = "DC_ADD(" + a + ", " + b + ")";
+            break;
+        case SUB_OP:
+            value = "DC_SUB(" + a + ", " + b + ")";
+            break;
+        case MULT_OP:
+            value = "DC_MUL(" + a + ", " + b + ")";
+            break;
+        case DIV_OP:
+            value = "dc_div(" + a + ", " + b + ", " + placeOf(em, ex.offset) + ")";
+            break;
+        case LESSER_OP:
+            value = "(long long)(" + a + " < " + b + ")";
+            break;
+        case GREATER_OP:
+            value = "(long long)(" + a + " > " + b + ")";
+            break;
+        case LEQUAL_OP:
+            value = "(long long)(" + a + " <= " + b + ")";
+            break;
+        case GEQUAL_OP:
+            value = "(long long)(" + a + " >= " + b + ")";
+            break;
+        case EQUAL_OP:
+            value = "(long long)(" + a + " == " + b + ")";
+            break;
+        default:
+            value = "(long long)(" + a + " != " + b + ")";
+            break;
+        }
+        // a temporary per operator pins the evaluation order
+        std::string t = fresh(em, "t");
+        line(em, "const long long " + t + " = " + value + ";");
+        values.push_back(t);
+    }
+    return values.back();
+}
+
+static void emitPostfix(dc_emitter *em, const std::vector<int> &postfix)
+{
+    for (size_t i = 0; i < postfix.size(); i++)
+    {
+        const dc_expr &ex = em->ast->exprs[postfix[i]];
+        const std::string &v = em->names[ex.symbol];
+        line(em, v + " = " + (ex.op == INC_OP ? "DC_ADD(" : "DC_SUB(") + v + ", 1);");
+    }
+}
+
+static bool bySymbol(const dc_copy &a, const dc_copy &b)
+{
+    return a.symbol < b.symbol;
+}
+
+/**
+ * @brief Open par { ... }. Nothing is conditional and do bodies run at
+ *  least once, so what a branch may assign is exactly what dc_run copies
+ *  back at the join; the copies are all taken before the first branch
+ */
+static void beginPar(dc_emitter *em, const dc_stmt &st)
+{
+    const dc_ast *ast = em->ast;
+    std::vector<std::vector<dc_copy> > copies; // per branch
+    std::vector<int> branches;
+
+    std::string at;
+    where(em->ctx, st.offset, &at);
+    line(em, "/* par" + at + " */");
+    line(em, "{");
+    em->depth++;
+    for (int b = st.body; b >= 0; b = ast->stmts[b].next)
+    {
+        std::vector<int> writes;
+        std::set<int> taken;
+        collectWrites(ast, b, &writes);
+        copies.push_back(std::vector<dc_copy>());
+        for (size_t w = 0; w < writes.size(); w++)
+        {
+            if (!taken.insert(writes[w]).second)
+                continue;
+            dc_copy c;
+            c.symbol = writes[w];
+            c.outer = em->names[c.symbol];
+            c.copy = fresh(em, "b");
+            line(em, "long long " + c.copy + " = " + c.outer + ";");
+            copies.back().push_back(c);
+        }
+        // joined in symbol order
+        std::sort(copies.back().begin(), copies.back().end(), bySymbol);
+        branches.push_back(b);
+    }
+    em->pars.push_back(copies);
+    em->parDepth++;
+
+    push(em, EMIT_JOIN, -1);
+    for (size_t k = branches.size(); k > 0; k--)
+    {
+        push(em, EMIT_BRANCH_END, (int)k - 1);
+        push(em, EMIT_STMT, branches[k - 1]);
+        push(em, EMIT_BRANCH, (int)k - 1);
+    }
+}
+
+/**
+ * @brief Close the innermost par: a later branch wins
+ */
+static void endPar(dc_emitter *em)
+{
+    const std::vector<std::vector<dc_copy> > &copies = em->pars.back();
+    em->parDepth--;
+    for (size_t k = 0; k < copies.size(); k++)
+        for (size_t c = 0; c < copies[k].size(); c++)
+            line(em, copies[k][c].outer + " = " + copies[k][c].copy + ";");
+    if (em->parDepth == 0)
+        line(em, "dc_release();");
+    em->depth--;
+    line(em, "}");
+    em->pars.pop_back();
+}
+
+/**
+ * @brief Lower statement s; a do or par leaves the rest of itself on the
+ *  work stack
+ */
+static void emitStmt(dc_emitter *em, int s)
+{
+    const dc_stmt &st = em->ast->stmts[s];
+    const char *name = dc_symbol_name(em->ctx, st.symbol);
+    std::vector<int> postfix;
+    std::string v, flag;
+
+    switch (st.kind)
+    {
+    case ASSIGN_OP:
+        v = emitExpr(em, st.expr, &postfix);
+        line(em, em->names[st.symbol] + " = " + v + ";");
+        emitPostfix(em, postfix);
+        break;
+    case KEY_READ:
+        line(em, em->names[st.symbol] + " = dc_read(\"" + name + "\", " +
+                     placeOf(em, st.offset) + ");");
+        break;
+    case KEY_WRITE:
+        if (em->parDepth > 0)
+            line(em, "dc_hold(" + em->names[st.symbol] + ");");
+        else
+            line(em, "printf(\"%lld\\n\", " + em->names[st.symbol] + ");");
+        break;
+    case KEY_DO:
+        flag = fresh(em, "c");
+        line(em, "long long " + flag + ";");
+        line(em, "do");
+        line(em, "{");
+        em->depth++;
+        push(em, EMIT_DO_END, s, flag);
+        push(em, EMIT_LIST, st.body);
+        break;
+    case KEY_PAR:
+        beginPar(em, st);
+        break;
+    }
+}
+
+/**
+ * @brief Lower the statements from s on, nested ones included, with the
+ *  work stack in place of recursion
+ */
+static void emitList(dc_emitter *em, int s)
+{
+    push(em, EMIT_LIST, s);
+    while (!em->work.empty())
+    {
+        dc_emit_item it = em->work.back();
+        em->work.pop_back();
+        std::vector<int> postfix;
+        std::string v;
+        switch (it.what)
+        {
+        case EMIT_LIST:
+            if (it.s < 0)
+                break;
+            push(em, EMIT_LIST, em->ast->stmts[it.s].next);
+            emitStmt(em, it.s);
+            break;
+        case EMIT_STMT:
+            emitStmt(em, it.s);
+            break;
+        case EMIT_DO_END:
+            v = emitExpr(em, em->ast->stmts[it.s].cond, &postfix);
+            line(em, it.text + " = " + v + ";");
+            emitPostfix(em, postfix);
+            em->depth--;
+            line(em, "} while (" + it.text + ");");
+            break;
+        case EMIT_BRANCH:
+        {
+            const std::vector<dc_copy> &copies = em->pars.back()[it.s];
+            for (size_t c = 0; c < copies.size(); c++)
+                em->names[copies[c].symbol] = copies[c].copy;
+            line(em, "{");
+            em->depth++;
+            break;
+        }
+        case EMIT_BRANCH_END:
+        {
+            const std::vector<dc_copy> &copies = em->pars.back()[it.s];
+            em->depth--;
+            line(em, "}");
+            for (size_t c = 0; c < copies.size(); c++)
+                em->names[copies[c].symbol] = copies[c].outer;
+            break;
+        }
+        case EMIT_JOIN:
+            endPar(em);
+            break;
+        }
+    }
+}
+
+int dc_emit_c(dc_context *ctx, FILE *out)
+{
+    if (ctx->exit_code != NoError)
+        return -1;
+
+    dc_emitter em;
+    em.ctx = ctx;
+    em.ast = &ctx->ast;
+    em.temps = 0;
+    em.depth = 1;
+    em.parDepth = 0;
+    em.out = "/* generated by libdcooke " + std::string(dc_version()) + " (dc_emit_c) */\n";
+    em.out += prelude;
+    em.out += "\nint main(void)\n{\n";
+    for (size_t v = 0; v < ctx->symbols.syms.size(); v++)
+    {
+        // symbol names are letters and digits; the prefix keeps them off C keywords
+        em.names.push_back(std::string("v_") + dc_symbol_name(ctx, (int)v));
+        line(&em, "long long " + em.names.back() + " = 0;");
+    }
+    emitList(&em, ctx->ast.first);
+    line(&em, "return 0;");
+    em.out += "}\n";
+
+    if (fwrite(em.out.data(), 1, em.out.size(), out) != em.out.size())
+        return -1;
+    return 0;
+}
@@ -0,0 +1,699 @@
+/*
+=============================================================================
+Title : exec.cpp
+Description : Bytecode compiler and interpreter of DCooke programs (dc_run).
+Author : silrodri (R#11679913)
+Date : 10/19/2026
+Version : 2.0
+Usage : Built into libdcooke; run after a successful dc_parse()
+Notes : The branches of a par run on the work-stealing pool (pool.h), each
+        on its own copy of the variables, so no variable is shared while
+        they run; see dc_par in exec.h for the join rule. read() is
+        rejected inside par by the parser, so input is only consumed on
+        the calling thread. Top-level write() output also goes out there.
+        A runtime error in a par is that of its lowest failed branch, with
+        the output of the branches up to it, as if they ran in order.
+        An exact run (dc_set_exact) checks + - * for overflow and moves
+        values that leave the long long range into bignums (bignum.h).
+C++ Version : cpp (GCC) 4.8.5 20150623 (Red Hat 4.8.5-16)
+=============================================================================
+*/
+#include <atomic>
+#include <climits>
+#include <utility>
+
+#include "bignum.h"
+#include "context.h"
+#include "exec.h"
+#include "pool.h"
+
+/******************************************************/
+/* Compiler */
+
+static void compileList(const dc_ast *ast, dc_program *prog, int s);
+
+/**
+ * @brief Append an instruction and return its pc
+ */
+static int emitOp(dc_program *prog, int op, int arg, long long imm, size_t offset)
+{
+    dc_insn in;
+    in.op = op;
+    in.arg = arg;
+    in.imm = imm;
+    in.offset = offset;
+    prog->code.push_back(in);
+    return (int)prog->code.size() - 1;
+}
+
+/**
+ * @brief The instruction of a binary operator token
+ */
+static int opOf(int token)
+{
+    int op = DC_OP_NE;
+    switch (token)
+    {
+    case ADD_OP:
+        op = DC_OP_ADD;
+        break;
+    case SUB_OP:
+        op = DC_OP_SUB;
+        break;
+    case MULT_OP:
+        op = DC_OP_MUL;
+        break;
+    case DIV_OP:
+        op = DC_OP_DIV;
+        break;
+    case LESSER_OP:
+        op = DC_OP_LT;
+        break;
+    case GREATER_OP:
+        op = DC_OP_GT;
+        break;
+    case LEQUAL_OP:
+        op = DC_OP_LE;
+        break;
+    case GEQUAL_OP:
+        op = DC_OP_GE;
+        break;
+    case EQUAL_OP:
+        op = DC_OP_EQ;
+        break;
+    }
+    return op;
+}
+
+/**
+ * @brief Compile an expression in postorder, collecting its postfix
+ *  operators
+ */
+static void compileExpr(const dc_ast *ast, dc_program *prog, int e, std::vector<int> *postfix)
+{
+    // (node, operands done): an operator is emitted on its second visit
+    std::vector<std::pair<int, bool> > work(1, std::make_pair(e, false));
+    while (!work.empty())
+    {
+        std::pair<int, bool> top = work.back();
+        work.pop_back();
+        const dc_expr &ex = ast->exprs[top.first];
+        switch (ex.op)
+        {
+        case INT_LIT:
+            emitOp(prog, DC_OP_PUSH, 0, ex.value, ex.offset);
+            continue;
+        case IDENT:
+            emitOp(prog, DC_OP_LOAD, ex.symbol, 0, ex.offset);
+            continue;
+        case INC_OP:
+        case DEC_OP:
+            emitOp(prog, DC_OP_LOAD, ex.symbol, 0, ex.offset);
+            postfix->push_back(top.first);
+            continue;
+        }
+        if (!top.second)
+        {
+            work.push_back(std::make_pair(top.first, true));
+            work.push_back(std::make_pair(ex.right, false));
+            work.push_back(std::make_pair(ex.left, false));
+            continue;
+        }
+        emitOp(prog, opOf(ex.op), 0, 0, ex.offset);
+    }
+}
+
+/**
+ * @brief Write back the postfix operators of a finished statement
+ */
+static void compilePostfix(const dc_ast *ast, dc_program *prog, const std::vector<int> &postfix)
+{
+    for (size_t i = 0; i < postfix.size(); i++)
+    {
+        const dc_expr &ex = ast->exprs[postfix[i]];
+        emitOp(prog, DC_OP_POST, ex.symbol, ex.op == INC_OP ? 1 : -1, ex.offset);
+    }
+}
+
+static void compileStmt(const dc_ast *ast, dc_program *prog, int s)
+{
+    const dc_stmt &st = ast->stmts[s];
+    std::vector<int> postfix;
+    int head, skip;
+    size_t par;
+    dc_loopform form;
+
+    if (prog->counters)
+        emitOp(prog, DC_OP_COUNT, s, 0, st.offset);
+    switch (st.kind)
+    {
+    case ASSIGN_OP:
+        compileExpr(ast, prog, st.expr, &postfix);
+        emitOp(prog, DC_OP_STORE, st.symbol, 0, st.offset);
+        compilePostfix(ast, prog, postfix);
+        break;
+    case KEY_READ:
+        emitOp(prog, DC_OP_READ, st.symbol, 0, st.offset);
+        break;
+    case KEY_WRITE:
+        emitOp(prog, DC_OP_WRITE, st.symbol, 0, st.offset);
+        break;
+    // CLOSED (when the loop has a closed form), then the loop as usual
+    case KEY_DO:
+        skip = -1;
+        if (prog->closed && !prog->counters && loopForm(ast, s, &form))
+        {
+            skip = emitOp(prog, DC_OP_CLOSED, (int)prog->loops.size(), 0, st.offset);
+            prog->loops.push_back(form);
+        }
+        head = (int)prog->code.size();
+        compileList(ast, prog, st.body);
+        if (prog->counters)
+            emitOp(prog, DC_OP_COUNT, (int)ast->stmts.size() + s, 0, st.offset);
+        compileExpr(ast, prog, st.cond, &postfix);
+        compilePostfix(ast, prog, postfix);
+        emitOp(prog, DC_OP_JNZ, head, 0, st.offset);
+        if (skip >= 0)
+            prog->code[skip].imm = (long long)prog->code.size();
+        break;
+    // PAR, JUMP over the branches, then each branch ending in END
+    case KEY_PAR:
+        par = prog->pars.size();
+        prog->pars.push_back(dc_par());
+        emitOp(prog, DC_OP_PAR, (int)par, 0, st.offset);
+        skip = emitOp(prog, DC_OP_JUMP, 0, 0, st.offset);
+        for (int b = st.body; b >= 0; b = ast->stmts[b].next)
+        {
+            prog->pars[par].branches.push_back((int)prog->code.size());
+            compileStmt(ast, prog, b);
+            emitOp(prog, DC_OP_END, 0, 0, ast->stmts[b].offset);
+        }
+        prog->code[skip].arg = (int)prog->code.size();
+        break;
+    }
+}
+
+static void compileList(const dc_ast *ast, dc_program *prog, int s)
+{
+    for (; s >= 0; s = ast->stmts[s].next)
+        compileStmt(ast, prog, s);
+}
+
+/**
+ * @brief Compile a whole program; it ends with DC_OP_END. A profiled
+ *  program counts every statement it starts and every do-while test.
+ *  With closed set, loops with a closed form try it first (not profiled,
+ *  since their statements would not be counted)
+ */
+void compileProgram(const dc_ast *ast, size_t symbols, bool profile, bool closed,
+                    dc_program *prog)
+{
+    prog->code.clear();
+    prog->pars.clear();
+    prog->loops.clear();
+    prog->symbols = symbols;
+    prog->counters = profile ? 2 * ast->stmts.size() : 0;
+    prog->closed = closed;
+    compileList(ast, prog, ast->first);
+    emitOp(prog, DC_OP_END, 0, 0, 0);
+}
+
+/******************************************************/
+/* Interpreter */
+
+/**
+ * @brief : Variables of the main program or of one par branch
+ */
+struct dc_env
+{
+    std::vector<long long> vars;
+    std::vector<char> written; // assigned since the env was created
+    std::vector<int> dirty;    // the symbols marked in written
+    std::vector<long long> out; // write() values held until the join
+    std::vector<unsigned long long> hits; // profiled: DC_OP_COUNT counters
+    std::vector<dc_bignum> big;           // exact: the value of each DC_BIG var
+    std::vector<std::string> outText;     // exact: the DC_BIG values held in out
+    bool failed;                          // stopped by a runtime error
+    std::string error, errorTail;         // its message, around the position
+    size_t errorAt;                       // of this source offset
+    // par branches: the lowest failed branch index of the par, this
+    // branch's index, and the env that ran the par
+    std::atomic<size_t> *lowest;
+    size_t index;
+    const dc_env *parent;
+};
+
+struct dc_runner
+{
+    const dc_program *prog;
+    const dc_context *ctx;
+    dc_pool *pool;
+    dc_read_fn in;
+    dc_write_fn out;
+    dc_write_text_fn outText; // exact: write() of a DC_BIG value
+    void *user;
+    bool exact;
+    std::atomic<bool> failed; // some env failed; see abandoned()
+};
+
+struct dc_branch
+{
+    dc_runner *run;
+    dc_env env;
+    int pc;
+};
+
+static void execute(dc_runner *r, dc_env *env, int pc, bool top);
+
+/**
+ * @brief Record a runtime error in env, which stops; in a par branch it
+ *  also stops the branches after it (see abandoned). dc_run puts the
+ *  position of offset between message and tail
+ */
+static void fail(dc_runner *r, dc_env *env, const std::string &message, size_t offset,
+                 const std::string &tail = "")
+{
+    env->failed = true;
+    env->error = message;
+    env->errorTail = tail;
+    env->errorAt = offset;
+    if (env->lowest)
+    {
+        size_t seen = env->lowest->load();
+        while (env->index < seen && !env->lowest->compare_exchange_weak(seen, env->index))
+            ;
+    }
+    r->failed.store(true, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Whether env's result can no longer matter: it, or a par branch
+ *  around it, comes after a branch of the same par that failed. Branches
+ *  before a failed one run on, so the error reported is always that of
+ *  the lowest failed branch, for any worker count
+ */
+static bool abandoned(const dc_env *env)
+{
+    for (const dc_env *e = env; e->lowest; e = e->parent)
+        if (e->lowest->load(std::memory_order_relaxed) < e->index)
+            return true;
+    return false;
+}
+
+static inline void store(dc_env *env, int sym, long long value)
+{
+    env->vars[sym] = value;
+    if (!env->written[sym])
+    {
+        env->written[sym] = 1;
+        env->dirty.push_back(sym);
+    }
+}
+
+/**
+ * @brief Exact runs: a long long, or DC_BIG with the number in *boxed,
+ *  as a bignum
+ */
+static void widen(long long v, const dc_bignum &boxed, dc_bignum *out)
+{
+    if (v == DC_BIG)
+        *out = boxed;
+    else
+        bigSet(out, v);
+}
+
+/**
+ * @brief Exact runs: the slot value for a result, moving it into *boxed
+ *  unless it fits a long long
+ */
+static long long narrow(dc_bignum *value, dc_bignum *boxed)
+{
+    long long v;
+    if (bigSmall(*value, &v) && v != DC_BIG)
+        return v;
+    boxed->negative = value->negative;
+    boxed->limbs.swap(value->limbs);
+    return DC_BIG;
+}
+
+/**
+ * @brief Exact runs: *x = *x op y where an operand is boxed or the long
+ *  long result overflowed. Comparisons leave 1 or 0
+ */
+static void bigArith(int op, long long *x, dc_bignum *bx, long long y, const dc_bignum &by)
+{
+    dc_bignum a, b;
+    widen(*x, *bx, &a);
+    widen(y, by, &b);
+    switch (op)
+    {
+    case DC_OP_ADD:
+        bigAdd(a, b, &a);
+        break;
+    case DC_OP_SUB:
+        bigSub(a, b, &a);
+        break;
+    case DC_OP_MUL:
+        bigMul(a, b, &a);
+        break;
+    case DC_OP_DIV:
+        bigDiv(a, b, &a);
+        break;
+    default:
+        int c = bigCompare(a, b);
+        *x = op == DC_OP_LT   ? c < 0
+             : op == DC_OP_GT ? c > 0
+             : op == DC_OP_LE ? c <= 0
+             : op == DC_OP_GE ? c >= 0
+             : op == DC_OP_EQ ? c == 0
+                              : c != 0;
+        return;
+    }
+    *x = narrow(&a, bx);
+}
+
+/**
+ * @brief write() of a variable; inside a par it is held in env until the
+ *  join
+ */
+static void writeVar(dc_runner *r, dc_env *env, int sym, bool top)
+{
+    long long v = env->vars[sym];
+    bool big = v == DC_BIG && r->exact;
+    if (!top)
+    {
+        env->out.push_back(v);
+        if (big)
+            env->outText.push_back(bigText(env->big[sym]));
+    }
+    else if (big)
+    {
+        if (r->outText)
+            r->outText(r->user, bigText(env->big[sym]).c_str());
+    }
+    else if (r->out)
+        r->out(r->user, v);
+}
+
+static void branchTask(void *arg)
+{
+    dc_branch *b = (dc_branch *)arg;
+    execute(b->run, &b->env, b->pc, false);
+}
+
+/**
+ * @brief Fork the branches of a par on the pool, wait, and merge them back
+ */
+static void runPar(dc_runner *r, dc_env *env, const dc_par &par, bool top)
+{
+    size_t n = par.branches.size();
+    std::vector<dc_branch> br(n);
+    std::atomic<int> pending((int)n - 1);
+    std::atomic<size_t> lowest(n);
+
+    for (size_t i = 0; i < n; i++)
+    {
+        br[i].run = r;
+        br[i].env.vars = env->vars;
+        br[i].env.big = env->big;
+        br[i].env.written.assign(env->vars.size(), 0);
+        br[i].env.hits.assign(r->prog->counters, 0);
+        br[i].env.failed = false;
+        br[i].env.lowest = &lowest;
+        br[i].env.index = i;
+        br[i].env.parent = env;
+        br[i].pc = par.branches[i];
+    }
+    for (size_t i = 1; i < n; i++)
+    {
+        dc_task task = {branchTask, &br[i], &pending};
+        poolFork(r->pool, task);
+    }
+    if (n > 0)
+        branchTask(&br[0]);
+    poolJoin(r->pool, &pending);
+
+    // after a failure only the branches up to the lowest failed one count,
+    // as if the branches had run one after another
+    if (lowest < n)
+        n = lowest + 1;
+    for (size_t i = 0; i < n; i++)
+    {
+        dc_env &b = br[i].env;
+        for (size_t d = 0; d < b.dirty.size(); d++)
+        {
+            int sym = b.dirty[d];
+            store(env, sym, b.vars[sym]);
+            if (b.vars[sym] == DC_BIG && r->exact)
+                std::swap(env->big[sym], b.big[sym]);
+        }
+        for (size_t c = 0; c < b.hits.size(); c++)
+            env->hits[c] += b.hits[c];
+        for (size_t o = 0, t = 0; o < b.out.size(); o++)
+        {
+            bool big = b.out[o] == DC_BIG && r->exact;
+            if (!top)
+            {
+                env->out.push_back(b.out[o]);
+                if (big)
+                    env->outText.push_back(b.outText[t++]);
+            }
+            else if (big)
+            {
+                if (r->outText)
+                    r->outText(r->user, b.outText[t++].c_str());
+            }
+            else if (r->out)
+                r->out(r->user, b.out[o]);
+        }
+        if (b.failed)
+            fail(r, env, b.error, b.errorAt, b.errorTail);
+    }
+}
+
+/**
+ * @brief Run code from pc until DC_OP_END or a runtime error
+ */
+static void execute(dc_runner *r, dc_env *env, int pc, bool top)
+{
+    const dc_insn *code = r->prog->code.data();
+    std::vector<long long> stack(16);
+    std::vector<dc_bignum> bigs; // exact: the number of each DC_BIG slot
+    size_t sp = 0;
+    unsigned long long a, b;
+    long long v;
+    bool exact = r->exact;
+
+    if (exact)
+        bigs.resize(stack.size());
+    for (;;)
+    {
+        const dc_insn &in = code[pc++];
+        if (sp + 1 >= stack.size())
+        {
+            stack.resize(stack.size() * 2);
+            if (exact)
+                bigs.resize(stack.size());
+        }
+        // exact: an operand that is DC_BIG or an overflow goes to bigArith
+        if (exact && in.op >= DC_OP_ADD && in.op <= DC_OP_NE)
+        {
+            long long &x = stack[sp - 2], y = stack[sp - 1];
+            bool big = x == DC_BIG || y == DC_BIG;
+            if (in.op == DC_OP_DIV && y == 0)
+            {
+                fail(r, env, "Error - division by zero", in.offset);
+                return;
+            }
+            if (big || (in.op == DC_OP_ADD && (addOverflow(x, y, &v) || v == DC_BIG)) ||
+                (in.op == DC_OP_SUB && (subOverflow(x, y, &v) || v == DC_BIG)) ||
+                (in.op == DC_OP_MUL && (mulOverflow(x, y, &v) || v == DC_BIG)))
+            {
+                bigArith(in.op, &x, &bigs[sp - 2], y, bigs[sp - 1]);
+                sp--;
+                continue;
+            }
+        }
+        switch (in.op)
+        {
+        case DC_OP_PUSH:
+            if ((stack[sp++] = in.imm) == DC_BIG && exact)
+                bigSet(&bigs[sp - 1], in.imm);
+            break;
+        case DC_OP_LOAD:
+            if ((stack[sp++] = env->vars[in.arg]) == DC_BIG && exact)
+                bigs[sp - 1] = env->big[in.arg];
+            break;
+        case DC_OP_STORE:
+            store(env, in.arg, stack[--sp]);
+            if (stack[sp] == DC_BIG && exact)
+                std::swap(env->big[in.arg], bigs[sp]);
+            break;
+        // wrap-around arithmetic, done unsigned to stay defined
+        case DC_OP_ADD:
+        case DC_OP_SUB:
+        case DC_OP_MUL:
+            b = (unsigned long long)stack[--sp];
+            a = (unsigned long long)stack[sp - 1];
+            stack[sp - 1] = (long long)(in.op == DC_OP_ADD   ? a + b
+                                        : in.op == DC_OP_SUB ? a - b
+                                                             : a * b);
+            break;
+        case DC_OP_DIV:
+            sp--;
+            if (stack[sp] == 0)
+            {
+                fail(r, env, "Error - division by zero", in.offset);
+                return;
+            }
+            if (stack[sp] == -1 && stack[sp - 1] == LLONG_MIN)
+                break; // LLONG_MIN / -1 wraps to itself
+            stack[sp - 1] /= stack[sp];
+            break;
+        case DC_OP_LT:
+            sp--;
+            stack[sp - 1] = stack[sp - 1] < stack[sp];
+            break;
+        case DC_OP_GT:
+            sp--;
+            stack[sp - 1] = stack[sp - 1] > stack[sp];
+            break;
+        case DC_OP_LE:
+            sp--;
+            stack[sp - 1] = stack[sp - 1] <= stack[sp];
+            break;
+        case DC_OP_GE:
+            sp--;
+            stack[sp - 1] = stack[sp - 1] >= stack[sp];
+            break;
+        case DC_OP_EQ:
+            sp--;
+            stack[sp - 1] = stack[sp - 1] == stack[sp];
+            break;
+        case DC_OP_NE:
+            sp--;
+            stack[sp - 1] = stack[sp - 1] != stack[sp];
+            break;
+        case DC_OP_POST:
+            if (exact && (env->vars[in.arg] == DC_BIG ||
+                          addOverflow(env->vars[in.arg], in.imm, &v) || v == DC_BIG))
+            {
+                dc_bignum step;
+                bigSet(&step, in.imm);
+                bigArith(DC_OP_ADD, &env->vars[in.arg], &env->big[in.arg], in.imm, step);
+                store(env, in.arg, env->vars[in.arg]);
+                break;
+            }
+            store(env, in.arg, (long long)((unsigned long long)env->vars[in.arg] + in.imm));
+            break;
+        case DC_OP_READ:
+            if (r->in == nullptr || r->in(r->user, &v) != 0)
+            {
+                fail(r, env, std::string("Error - read(") + dc_symbol_name(r->ctx, in.arg) + ")",
+                     in.offset, ": no more input");
+                return;
+            }
+            store(env, in.arg, v);
+            if (v == DC_BIG && exact)
+                bigSet(&env->big[in.arg], v);
+            break;
+        case DC_OP_WRITE:
+            writeVar(r, env, in.arg, top);
+            break;
+        case DC_OP_JNZ:
+            // a back edge is where a failed sibling branch stops this one
+            if (stack[--sp] != 0)
+            {
+                if (r->failed.load(std::memory_order_relaxed) && abandoned(env))
+                    return;
+                pc = in.arg;
+            }
+            break;
+        case DC_OP_JUMP:
+            pc = in.arg;
+            break;
+        case DC_OP_PAR:
+            runPar(r, env, r->prog->pars[in.arg], top);
+            if (env->failed)
+                return;
+            break;
+        case DC_OP_COUNT:
+            env->hits[in.arg]++;
+            break;
+        case DC_OP_CLOSED:
+        {
+            const dc_loopform &loop = r->prog->loops[in.arg];
+            long long values[MAX_IVS];
+            if (runClosed(&r->ctx->ast, &loop, env->vars.data(), values))
+            {
+                for (int i = 0; i < loop.count; i++)
+                    store(env, loop.vars[i], values[i]);
+                pc = (int)in.imm;
+            }
+            break;
+        }
+        case DC_OP_END:
+            return;
+        }
+    }
+}
+
+void dc_set_exact(dc_context *ctx, int on, dc_write_text_fn text_fn)
+{
+    ctx->exact = on != 0;
+    ctx->exactText = text_fn;
+}
+
+/**
+ * @brief Execute the program of the last successful dc_parse
+ */
+exitCode dc_run(dc_context *ctx, unsigned workers, dc_read_fn in, dc_write_fn out, void *user)
+{
+    if (ctx->exit_code != NoError)
+        return ctx->exit_code;
+
+    dc_program prog;
+    // closed forms compute in wrapping arithmetic, so exact runs step loops
+    compileProgram(&ctx->ast, ctx->symbols.syms.size(), ctx->profiling,
+                   ctx->closedForms && !ctx->exact, &prog);
+
+    dc_runner r;
+    r.prog = &prog;
+    r.ctx = ctx;
+    r.in = in;
+    r.out = out;
+    r.outText = ctx->exactText;
+    r.user = user;
+    r.exact = ctx->exact;
+    r.failed = false;
+    // threads only when there is something to run in parallel
+    r.pool = prog.pars.empty() ? nullptr : poolCreate(workers);
+
+    dc_env env;
+    env.vars.assign(prog.symbols, 0);
+    env.written.assign(prog.symbols, 0);
+    env.hits.assign(prog.counters, 0);
+    if (r.exact)
+        env.big.resize(prog.symbols);
+    env.failed = false;
+    env.lowest = nullptr;
+    env.index = 0;
+    env.parent = nullptr;
+    execute(&r, &env, 0, true);
+    if (r.pool)
+        poolDestroy(r.pool);
+
+    // counts add up over the runs of one profiling session
+    ctx->hits.resize(prog.counters);
+    for (size_t c = 0; c < prog.counters; c++)
+        ctx->hits[c] += env.hits[c];
+
+    if (env.failed)
+    {
+        // here, as branches fail on worker threads
+        where(ctx, env.errorAt, &env.error);
+        report(ctx, DC_DIAG_RUNTIME, env.error + env.errorTail, env.errorAt);
+        ctx->exit_code = RuntimeError;
+    }
+    return ctx->exit_code;
+}
@@ -0,0 +1,98 @@
+/*
+=============================================================================
+Title : exec.h
+Description : Bytecode of a parsed DCooke program and its interpreter.
+Author : silrodri (R#11679913)
+Date : 10/19/2026
+Version : 2.0
+Usage : Internal to libdcooke; compileProgram() turns the AST into a
+        dc_program that dc_run() executes
+Notes : A stack machine. Every variable is a 64-bit integer that starts at
+        0. Arithmetic wraps and division by zero is a runtime error.
+        Postfix ++/-- yields the old value and writes back once its
+        statement (or do-while condition) is done.
+C++ Version : cpp (GCC) 4.8.5 20150623 (Red Hat 4.8.5-16)
+=============================================================================
+*/
+#ifndef EXEC_H
+#define EXEC_H
+
+#include <stddef.h>
+#include <vector>
+
+#include "ast.h"
+
+/* Opcodes; 'arg' is a symbol, jump target or par index as noted */
+#define DC_OP_PUSH 0  /* push imm */
+#define DC_OP_LOAD 1  /* push var[arg] */
+#define DC_OP_STORE 2 /* var[arg] = pop */
+#define DC_OP_ADD 3
+#define DC_OP_SUB 4
+#define DC_OP_MUL 5
+#define DC_OP_DIV 6
+#define DC_OP_LT 7 /* comparisons push 1 or 0 */
+#define DC_OP_GT 8
+#define DC_OP_LE 9
+#define DC_OP_GE 10
+#define DC_OP_EQ 11
+#define DC_OP_NE 12
+#define DC_OP_POST 13  /* var[arg] += imm (postfix write-back) */
+#define DC_OP_READ 14  /* var[arg] = next input value */
+#define DC_OP_WRITE 15 /* output var[arg] */
+#define DC_OP_JNZ 16   /* if pop != 0 goto arg */
+#define DC_OP_JUMP 17  /* goto arg */
+#define DC_OP_PAR 18   /* run the branches of pars[arg], then join */
+#define DC_OP_END 19   /* end of the program or of a par branch */
+#define DC_OP_COUNT 20 /* hits[arg]++ (profiled programs only) */
+#define DC_OP_CLOSED 21 /* run loops[arg] in closed form and goto imm, if it can */
+
+#define MAX_IVS 8 // variables a closed-form loop may change
+
+struct dc_insn
+{
+    int op;
+    int arg;
+    long long imm;
+    size_t offset; // source byte offset, for runtime errors
+};
+
+/**
+ * @brief : A par statement: each branch starts on a snapshot of the
+ *  variables; at the join the variables each branch assigned are copied
+ *  back in branch order (a later branch wins) and their write() output is
+ *  emitted in the same order
+ */
+struct dc_par
+{
+    std::vector<int> branches; // entry pc of each branch
+};
+
+/**
+ * @brief : A do-while that may run in closed form (indvar.cpp): the
+ *  variables it changes, in symbol order
+ */
+struct dc_loopform
+{
+    int stmt;
+    int vars[MAX_IVS];
+    int count;
+};
+
+struct dc_program
+{
+    std::vector<dc_insn> code; // starts at pc 0
+    std::vector<dc_par> pars;
+    std::vector<dc_loopform> loops;
+    size_t symbols;
+    size_t counters; // profiled: 2 per statement (see dc_context::hits), else 0
+    bool closed;     // loops with a closed form start with DC_OP_CLOSED
+};
+
+void compileProgram(const dc_ast *ast, size_t symbols, bool profile, bool closed,
+                    dc_program *prog);
+
+/* indvar.cpp */
+bool loopForm(const dc_ast *ast, int s, dc_loopform *loop);
+bool runClosed(const dc_ast *ast, const dc_loopform *loop, const long long *vars, long long *out);
+
+#endif
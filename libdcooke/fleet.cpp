@@ -0,0 +1,482 @@
+/*
+=============================================================================
+Title : fleet.cpp
+Description : Many program instances as coroutines on one thread
+              (dc_fleet_*).
+Author : silrodri (R#11679913)
+Date : 10/19/2026
+Version : 2.0
+Usage : Built into libdcooke; see dc_fleet_create() in dcooke.h
+Notes : An instance is stackless: everything execute() in exec.cpp keeps
+        in locals (pc, operand stack, open par statements) lives in the
+        instance, so a turn can stop after any instruction and resume
+        there later. Variables and the operand stack share one array; the
+        stack is sized from the bytecode, since it is only non-empty
+        inside one statement. A FIFO ready queue hands out turns. An
+        instance waiting in read() is off the queue until a value is fed,
+        so 100k idle instances cost their memory and nothing else. par
+        branches run in order on the instance's variables: each branch's
+        assignments are saved and undone at its END, and replayed in
+        branch order at the join (the dc_run rule); write() inside par is
+        held until the outermost join.
+C++ Version : cpp (GCC) 4.8.5 20150623 (Red Hat 4.8.5-16)
+=============================================================================
+*/
+#include <algorithm>
+#include <climits>
+#include <deque>
+#include <new>
+
+#include "context.h"
+#include "exec.h"
+
+#define QUANTUM 10000 // default instructions per turn
+
+/* Instance states */
+#define INST_FREE 0
+#define INST_READY 1   // on the ready queue
+#define INST_WAITING 2 // in read() with nothing fed
+
+/**
+ * @brief : One program, compiled once for every instance of it
+ */
+struct dc_fleetprog
+{
+    dc_context *ctx;
+    dc_program prog;
+    size_t slots; // variables plus the deepest operand stack
+};
+
+/**
+ * @brief : An open par statement of an instance
+ */
+struct dc_parframe
+{
+    int pc;        // of the DC_OP_PAR
+    size_t branch; // branch running
+    std::vector<long long> before;  // value of each var the branch assigned ...
+    std::vector<int> dirty;         // ... and which vars those are
+    std::vector<char> written;      // per var: in dirty
+    std::vector<std::pair<int, long long> > joined; // assignments of finished branches
+};
+
+struct dc_inst
+{
+    const dc_fleetprog *prog;
+    int state;
+    int pc;
+    size_t sp;                    // operand stack top, in slots
+    unsigned long long steps;     // instructions run
+    std::vector<long long> slots; // variables, then the operand stack
+    std::vector<long long> input; // values fed and not yet read
+    size_t taken;
+    bool ended; // dc_fleet_end_input was called
+    std::vector<dc_parframe> pars;
+    std::vector<long long> held; // write() output inside par
+};
+
+struct dc_fleet
+{
+    dc_fleet_io io;
+    unsigned long long quantum, limit;
+    std::vector<dc_fleetprog *> progs;
+    std::deque<dc_inst> insts; // by id; a deque keeps them in place on growth
+    std::vector<long> freeIds;
+    std::deque<long> ready;
+    size_t waiting;
+};
+
+/**
+ * @brief Operand stack depth needed by a program. Jumps only happen
+ *  between statements, where the stack is empty, so one pass in code
+ *  order sees every depth
+ */
+static size_t stackDepth(const dc_program &prog)
+{
+    size_t depth = 0, deepest = 0;
+    for (size_t pc = 0; pc < prog.code.size(); pc++)
+    {
+        switch (prog.code[pc].op)
+        {
+        case DC_OP_PUSH:
+        case DC_OP_LOAD:
+            deepest = std::max(deepest, ++depth);
+            break;
+        case DC_OP_POST:
+        case DC_OP_READ:
+        case DC_OP_WRITE:
+        case DC_OP_JUMP:
+        case DC_OP_PAR:
+        case DC_OP_END:
+        case DC_OP_COUNT:
+            break;
+        default: // STORE, JNZ and the binary operators pop one
+            depth--;
+            break;
+        }
+    }
+    return deepest;
+}
+
+dc_fleet *dc_fleet_create(const dc_fleet_io *io, unsigned long long quantum,
+                          unsigned long long limit)
+{
+    dc_fleet *fleet = new (std::nothrow) dc_fleet();
+    if (fleet == nullptr)
+        return nullptr;
+    if (io)
+        fleet->io = *io;
+    fleet->quantum = quantum ? quantum : QUANTUM;
+    fleet->limit = limit;
+    fleet->waiting = 0;
+    return fleet;
+}
+
+void dc_fleet_destroy(dc_fleet *fleet)
+{
+    if (fleet == nullptr)
+        return;
+    for (size_t p = 0; p < fleet->progs.size(); p++)
+        delete fleet->progs[p];
+    delete fleet;
+}
+
+long dc_fleet_spawn(dc_fleet *fleet, dc_context *ctx)
+{
+    if (ctx->exit_code != NoError)
+        return -1;
+    const dc_fleetprog *prog = nullptr;
+    for (size_t p = 0; p < fleet->progs.size() && prog == nullptr; p++)
+        if (fleet->progs[p]->ctx == ctx)
+            prog = fleet->progs[p];
+    if (prog == nullptr)
+    {
+        dc_fleetprog *fresh = new dc_fleetprog();
+        fresh->ctx = ctx;
+        compileProgram(&ctx->ast, ctx->symbols.syms.size(), false, false, &fresh->prog);
+        fresh->slots = fresh->prog.symbols + stackDepth(fresh->prog);
+        fleet->progs.push_back(fresh);
+        prog = fresh;
+    }
+
+    long id;
+    if (!fleet->freeIds.empty())
+    {
+        id = fleet->freeIds.back();
+        fleet->freeIds.pop_back();
+    }
+    else
+    {
+        id = (long)fleet->insts.size();
+        fleet->insts.push_back(dc_inst());
+    }
+    dc_inst &in = fleet->insts[id];
+    in.prog = prog;
+    in.state = INST_READY;
+    in.pc = 0;
+    in.sp = prog->prog.symbols;
+    in.steps = 0;
+    in.slots.assign(prog->slots, 0);
+    in.taken = 0;
+    in.ended = false;
+    fleet->ready.push_back(id);
+    return id;
+}
+
+static dc_inst *lookup(dc_fleet *fleet, long id)
+{
+    if (id < 0 || id >= (long)fleet->insts.size() || fleet->insts[id].state == INST_FREE)
+        return nullptr;
+    return &fleet->insts[id];
+}
+
+/**
+ * @brief Put a waiting instance back on the ready queue
+ */
+static void wake(dc_fleet *fleet, long id, dc_inst *in)
+{
+    if (in->state != INST_WAITING)
+        return;
+    in->state = INST_READY;
+    fleet->waiting--;
+    fleet->ready.push_back(id);
+}
+
+int dc_fleet_feed(dc_fleet *fleet, long id, long long value)
+{
+    dc_inst *in = lookup(fleet, id);
+    if (in == nullptr)
+        return -1;
+    in->input.push_back(value);
+    wake(fleet, id, in);
+    return 0;
+}
+
+int dc_fleet_end_input(dc_fleet *fleet, long id)
+{
+    dc_inst *in = lookup(fleet, id);
+    if (in == nullptr)
+        return -1;
+    in->ended = true;
+    wake(fleet, id, in);
+    return 0;
+}
+
+/**
+ * @brief Hand write(V) output to the host
+ */
+static void emit(dc_fleet *fleet, long id, long long value)
+{
+    if (fleet->io.write_fn)
+        fleet->io.write_fn(fleet->io.user, id, value);
+}
+
+/**
+ * @brief End an instance: flush held par output, report, free its id
+ */
+static void finish(dc_fleet *fleet, long id, exitCode code, const std::string &message)
+{
+    dc_inst &in = fleet->insts[id];
+    for (size_t o = 0; o < in.held.size(); o++)
+        emit(fleet, id, in.held[o]);
+    // release the memory; the id goes back on the free list
+    std::vector<long long>().swap(in.slots);
+    std::vector<long long>().swap(in.input);
+    std::vector<long long>().swap(in.held);
+    std::vector<dc_parframe>().swap(in.pars);
+    in.state = INST_FREE;
+    fleet->freeIds.push_back(id);
+    if (fleet->io.exit_fn)
+        fleet->io.exit_fn(fleet->io.user, id, code, message.empty() ? nullptr : message.c_str());
+}
+
+static inline void store(dc_inst *in, int sym, long long value)
+{
+    if (!in->pars.empty())
+    {
+        dc_parframe &f = in->pars.back();
+        if (!f.written[sym])
+        {
+            f.written[sym] = 1;
+            f.dirty.push_back(sym);
+            f.before.push_back(in->slots[sym]);
+        }
+    }
+    in->slots[sym] = value;
+}
+
+/**
+ * @brief DC_OP_END inside a par: keep the branch's assignments, undo them,
+ *  then start the next branch or join. Returns the pc to go on at
+ */
+static int endBranch(dc_fleet *fleet, long id, dc_inst *in)
+{
+    const dc_program &prog = in->prog->prog;
+    dc_parframe &f = in->pars.back();
+    const dc_par &par = prog.pars[prog.code[f.pc].arg];
+    for (size_t d = 0; d < f.dirty.size(); d++)
+    {
+        f.joined.push_back(std::make_pair(f.dirty[d], in->slots[f.dirty[d]]));
+        in->slots[f.dirty[d]] = f.before[d];
+        f.written[f.dirty[d]] = 0;
+    }
+    f.dirty.clear();
+    f.before.clear();
+    if (++f.branch < par.branches.size())
+        return par.branches[f.branch];
+
+    // join: replay in branch order, a later branch wins
+    int pc = f.pc + 1;
+    std::vector<std::pair<int, long long> > joined;
+    joined.swap(f.joined);
+    in->pars.pop_back();
+    for (size_t j = 0; j < joined.size(); j++)
+        store(in, joined[j].first, joined[j].second);
+    if (in->pars.empty())
+    {
+        for (size_t o = 0; o < in->held.size(); o++)
+            emit(fleet, id, in->held[o]);
+        in->held.clear();
+    }
+    return pc;
+}
+
+/**
+ * @brief One turn of instance id: up to quantum instructions. Returns
+ *  false when the instance waits or has exited
+ */
+static bool turn(dc_fleet *fleet, long id)
+{
+    dc_inst *in = &fleet->insts[id];
+    const dc_program &prog = in->prog->prog;
+    const dc_insn *code = prog.code.data();
+    long long *stack = in->slots.data();
+    size_t sp = in->sp;
+    int pc = in->pc;
+    unsigned long long a, b, budget = fleet->quantum, left;
+    std::string error;
+    exitCode result = RuntimeError;
+
+    if (fleet->limit && fleet->limit - in->steps < budget)
+        budget = fleet->limit - in->steps;
+    for (left = budget; left > 0; left--)
+    {
+        const dc_insn &op = code[pc++];
+        switch (op.op)
+        {
+        case DC_OP_PUSH:
+            stack[sp++] = op.imm;
+            continue;
+        case DC_OP_LOAD:
+            stack[sp++] = stack[op.arg];
+            continue;
+        case DC_OP_STORE:
+            store(in, op.arg, stack[--sp]);
+            continue;
+        // wrap-around arithmetic, done unsigned to stay defined
+        case DC_OP_ADD:
+        case DC_OP_SUB:
+        case DC_OP_MUL:
+            b = (unsigned long long)stack[--sp];
+            a = (unsigned long long)stack[sp - 1];
+            stack[sp - 1] = (long long)(op.op == DC_OP_ADD   ? a + b
+                                        : op.op == DC_OP_SUB ? a - b
+                                                             : a * b);
+            continue;
+        case DC_OP_DIV:
+            sp--;
+            if (stack[sp] == 0)
+            {
+                error = "Error - division by zero";
+                where(in->prog->ctx, op.offset, &error);
+                break;
+            }
+            // LLONG_MIN / -1 wraps to itself
+            if (stack[sp] != -1 || stack[sp - 1] != LLONG_MIN)
+                stack[sp - 1] /= stack[sp];
+            continue;
+        case DC_OP_LT:
+            sp--;
+            stack[sp - 1] = stack[sp - 1] < stack[sp];
+            continue;
+        case DC_OP_GT:
+            sp--;
+            stack[sp - 1] = stack[sp - 1] > stack[sp];
+            continue;
+        case DC_OP_LE:
+            sp--;
+            stack[sp - 1] = stack[sp - 1] <= stack[sp];
+            continue;
+        case DC_OP_GE:
+            sp--;
+            stack[sp - 1] = stack[sp - 1] >= stack[sp];
+            continue;
+        case DC_OP_EQ:
+            sp--;
+            stack[sp - 1] = stack[sp - 1] == stack[sp];
+            continue;
+        case DC_OP_NE:
+            sp--;
+            stack[sp - 1] = stack[sp - 1] != stack[sp];
+            continue;
+        case DC_OP_POST:
+            store(in, op.arg, (long long)((unsigned long long)stack[op.arg] + op.imm));
+            continue;
+        case DC_OP_READ:
+            if (in->taken < in->input.size())
+            {
+                store(in, op.arg, in->input[in->taken++]);
+                if (in->taken == in->input.size())
+                {
+                    in->input.clear();
+                    in->taken = 0;
+                }
+                continue;
+            }
+            if (in->ended)
+            {
+                error = std::string("Error - read(") + dc_symbol_name(in->prog->ctx, op.arg) + ")";
+                where(in->prog->ctx, op.offset, &error);
+                error += ": no more input";
+                break;
+            }
+            // suspend; the read runs again once a value is fed
+            in->pc = pc - 1;
+            in->sp = sp;
+            in->state = INST_WAITING;
+            fleet->waiting++;
+            if (fleet->io.wait_fn)
+                fleet->io.wait_fn(fleet->io.user, id);
+            return false;
+        case DC_OP_WRITE:
+            if (!in->pars.empty())
+            {
+                in->held.push_back(stack[op.arg]);
+                continue;
+            }
+            // yield after handing the value out
+            in->pc = pc;
+            in->sp = sp;
+            in->steps += budget - left + 1;
+            emit(fleet, id, stack[op.arg]);
+            return true;
+        case DC_OP_JNZ:
+            if (stack[--sp] != 0)
+                pc = op.arg;
+            continue;
+        case DC_OP_JUMP:
+            pc = op.arg;
+            continue;
+        case DC_OP_PAR:
+            if (prog.pars[op.arg].branches.empty())
+                continue;
+            in->pars.push_back(dc_parframe());
+            in->pars.back().pc = pc - 1;
+            in->pars.back().branch = 0;
+            in->pars.back().written.assign(prog.symbols, 0);
+            pc = prog.pars[op.arg].branches[0];
+            continue;
+        case DC_OP_END:
+            if (!in->pars.empty())
+            {
+                pc = endBranch(fleet, id, in);
+                continue;
+            }
+            result = NoError;
+            break;
+        case DC_OP_COUNT:
+            continue;
+        }
+        break; // the instance is done
+    }
+
+    if (left > 0)
+    {
+        finish(fleet, id, result, error);
+        return false;
+    }
+    in->pc = pc;
+    in->sp = sp;
+    in->steps += budget;
+    if (fleet->limit && in->steps >= fleet->limit)
+    {
+        std::string why = "Error - instruction limit of " + std::to_string(fleet->limit) +
+                          " reached";
+        where(in->prog->ctx, code[pc].offset, &why);
+        finish(fleet, id, LimitExceeded, why);
+        return false;
+    }
+    return true;
+}
+
+size_t dc_fleet_run(dc_fleet *fleet)
+{
+    while (!fleet->ready.empty())
+    {
+        long id = fleet->ready.front();
+        fleet->ready.pop_front();
+        if (turn(fleet, id))
+            fleet->ready.push_back(id);
+    }
+    return fleet->waiting;
+}
@@ -0,0 +1,131 @@
+/*
+=============================================================================
+Title : format.cpp
+Description : Canonical source formatter and token hash (dc_format).
+Author : silrodri (R#11679913)
+Date : 10/19/2026
+Version : 2.0
+Usage : Built into libdcooke; see dc_format() in dcooke.h
+Notes : Works on the token stream as the lexer's scanner produces it, so a
+        streamed source is formatted while it is still being read, and no
+        token is recorded, decoded or interned on the way. Each token is
+        laid out from the one before it alone: a statement per line, four
+        spaces per open brace, one space between tokens except where the
+        language never puts one. Only the blanks between tokens change, and
+        two tokens are never joined where that would lex differently, so
+        formatting twice gives the same text. The hash covers the tokens
+        and not the blanks, which makes it a cache key that survives
+        reformatting. The SHA-256 digest covers the same bytes, for keys
+        that must hold against crafted collisions.
+C++ Version : cpp (GCC) 4.8.5 20150623 (Red Hat 4.8.5-16)
+=============================================================================
+*/
+#include <cstring>
+#include <string>
+
+#include "context.h"
+
+#define FLUSH_AT 65536 // bytes of output buffered between fwrite calls
+
+#define FNV_OFFSET 14695981039346656037ULL
+#define FNV_PRIME 1099511628211ULL
+
+/**
+ * @brief The blanks that go between prev and cur (prev < 0 for the first
+ *  token); depth is the brace depth, updated for cur
+ */
+static void separate(int prev, int cur, int *depth, std::string *out)
+{
+    bool newline = false;
+    if (prev < 0)
+        return;
+    if (cur == RIGHT_CBRACE)
+    {
+        if (*depth > 0)
+            --*depth;
+        newline = true;
+    }
+    else if (prev == LEFT_CBRACE || prev == SEMICOLON)
+        newline = true;
+    else if (prev == RIGHT_CBRACE)
+        newline = cur != KEY_WHILE && cur != SEMICOLON;
+    if (newline)
+    {
+        *out += '\n';
+        out->append(4 * (size_t)*depth, ' ');
+        return;
+    }
+    // joined: nothing lexes differently without the blank
+    if (cur == SEMICOLON || cur == RIGHT_PAREN || prev == LEFT_PAREN)
+        return;
+    if (cur == LEFT_PAREN && (prev == KEY_READ || prev == KEY_WRITE))
+        return;
+    // postfix x++ and x--, but "+ ++" must not become "+++"
+    if ((cur == INC_OP || cur == DEC_OP) && prev != ADD_OP && prev != SUB_OP &&
+        prev != INC_OP && prev != DEC_OP)
+        return;
+    *out += ' ';
+}
+
+/**
+ * @brief Scan the whole input, writing each token as it comes
+ */
+int dc_format(dc_context *ctx, FILE *out)
+{
+    std::string text;
+    unsigned long long hash = FNV_OFFSET;
+    dc_sha256 digest;
+    int code, prev = -1, depth = 0;
+    bool failed = false;
+
+    beginRun(ctx);
+    shaBegin(&digest);
+    while ((code = scan(ctx)) != EOF)
+    {
+        const char *p = &ctx->src[ctx->tokenStart];
+        size_t len = ctx->pos - ctx->tokenStart;
+
+        // FNV-1a over the bytes, after the length in one step, so that
+        // "ab" and "a b" hash apart
+        hash = (hash ^ len) * FNV_PRIME;
+        for (size_t i = 0; i < len; i++)
+            hash = (hash ^ (unsigned char)p[i]) * FNV_PRIME;
+        // the digest takes the length as 8 bytes, little-endian
+        unsigned char lenBytes[8];
+        for (int i = 0; i < 8; i++)
+            lenBytes[i] = (unsigned char)((unsigned long long)len >> (8 * i));
+        shaAdd(&digest, lenBytes, sizeof lenBytes);
+        shaAdd(&digest, p, len);
+
+        if (out == nullptr)
+            continue;
+        separate(prev, code, &depth, &text);
+        text.append(p, len);
+        if (code == LEFT_CBRACE)
+            depth++;
+        prev = code;
+        if (text.size() >= FLUSH_AT)
+        {
+            failed |= fwrite(text.data(), 1, text.size(), out) != text.size();
+            text.clear();
+        }
+    }
+    ctx->tokenHash = hash;
+    shaEnd(&digest, ctx->tokenDigest);
+    if (out == nullptr)
+        return 0;
+    if (prev >= 0)
+        text += '\n';
+    failed |= fwrite(text.data(), 1, text.size(), out) != text.size();
+    return failed ? -1 : 0;
+}
+
+unsigned long long dc_token_hash(const dc_context *ctx)
+{
+    return ctx->tokenHash;
+}
+
+void dc_token_digest(const dc_context *ctx, unsigned char digest[32])
+{
+    memcpy(digest, ctx->tokenDigest, sizeof ctx->tokenDigest);
+}
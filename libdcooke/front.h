@@ -1,11 +1,12 @@
 /*
 =============================================================================
 Title : front.h
-Description : This is a header for the lexical analyzer program.
+Description : Character classes and token codes shared by libdcooke and its
+              front-ends.
 Author : silrodri (R#11679913)
-Date : 10/19/2023
-Version : 1.0
-Usage : Imported into main.cpp and parser.cpp
+Date : 10/19/2026
+Version : 2.0
+Usage : Included by dcooke.h; safe to include from C or C++
 Notes : This example program has no requirements.
 C++ Version : cpp (GCC) 4.8.5 20150623 (Red Hat 4.8.5-16)
 =============================================================================
@@ -45,7 +46,6 @@ C++ Version : cpp (GCC) 4.8.5 20150623 (Red Hat 4.8.5-16)
 #define KEY_DO 31
 #define IDENT 32
 #define INT_LIT 33
-
-int lex();
+#define KEY_PAR 34
 
 #endif
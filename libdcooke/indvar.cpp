@@ -0,0 +1,616 @@
+/*
+=============================================================================
+Title : indvar.cpp
+Description : Induction variables of do-while loops and closed-form
+              execution of whole loops (dc_close_loops).
+Author : silrodri (R#11679913)
+Date : 10/19/2026
+Version : 2.0
+Usage : Built into libdcooke; run after a successful dc_parse(), then
+        dc_run() uses the closed forms
+Notes : A candidate loop has a body of assignments only, and every value
+        it computes is affine in the variables the loop changes: a sum of
+        them times values the loop does not change. One pass over the body
+        then gives the iteration as x' = A x + b (mod 2^64). On entry
+        dc_run fills in the unchanged variables and solves for the trip
+        count: each side of the condition must move by the same amount
+        every iteration (g A = g for its coefficients g), so one division
+        gives the iteration where it first fails, provided neither side
+        wraps before then. The loop then runs as A^K x + ... by repeated squaring.
+        Whenever a step of this is not possible (a zero divisor, a bound
+        that is never reached or wraps) the loop is stepped as usual, so
+        a closed form never changes what a program does.
+C++ Version : cpp (GCC) 4.8.5 20150623 (Red Hat 4.8.5-16)
+=============================================================================
+*/
+#include <algorithm>
+#include <climits>
+
+#include "cfg.h"
+#include "context.h"
+#include "exec.h"
+
+#define NO_OFFSET ((size_t)-1)
+
+typedef unsigned long long u64;
+typedef __int128 i128;
+
+/**
+ * @brief : A value as c[0] x0 + ... + c[n-1] x(n-1) + c[n], where xi is
+ *  the i-th loop variable at the top of the iteration. Before dc_run the
+ *  unchanged variables are not known; unknown marks what depends on them
+ */
+struct dc_form
+{
+    u64 c[MAX_IVS + 1];
+    char unknown[MAX_IVS + 1];
+};
+
+/**
+ * @brief : One symbolic pass over a loop
+ */
+struct dc_closer
+{
+    const dc_ast *ast;
+    const dc_loopform *loop;
+    const long long *vars;   // all variables on entry, NULL for the static check
+    dc_form state[MAX_IVS];  // each loop variable after the statements so far
+    dc_form left, right;     // sides of the condition
+    int test;                // LESSER_OP ... NEQUAL_OP comparing them
+    size_t bad;              // what stopped the pass, or NO_OFFSET
+    const char *why;
+    std::vector<std::pair<int, bool> > work; // evalExpr: (node, operands done)
+    std::vector<dc_form> values;             // evalExpr: operand values
+};
+
+static int slotOf(const dc_loopform *loop, int symbol)
+{
+    for (int i = 0; i < loop->count; i++)
+        if (loop->vars[i] == symbol)
+            return i;
+    return -1;
+}
+
+static void constant(dc_form *f, int n, u64 value, bool unknown)
+{
+    for (int j = 0; j <= n; j++)
+    {
+        f->c[j] = 0;
+        f->unknown[j] = 0;
+    }
+    f->c[n] = value;
+    f->unknown[n] = unknown;
+}
+
+/**
+ * @brief Whether f does not depend on the loop variables
+ */
+static bool invariant(const dc_form &f, int n)
+{
+    for (int j = 0; j < n; j++)
+        if (f.c[j] != 0 || f.unknown[j])
+            return false;
+    return true;
+}
+
+static bool isComparison(int op)
+{
+    return op == LESSER_OP || op == GREATER_OP || op == LEQUAL_OP || op == GEQUAL_OP ||
+           op == EQUAL_OP || op == NEQUAL_OP;
+}
+
+static bool compare(int op, long long a, long long b)
+{
+    switch (op)
+    {
+    case LESSER_OP:
+        return a < b;
+    case GREATER_OP:
+        return a > b;
+    case LEQUAL_OP:
+        return a <= b;
+    case GEQUAL_OP:
+        return a >= b;
+    case EQUAL_OP:
+        return a == b;
+    }
+    return a != b;
+}
+
+/**
+ * @brief Value of leaf e (literal or variable) into *out; postfix operators
+ *  are collected for the end of the statement. False for an operator
+ */
+static bool evalLeaf(dc_closer *cl, int e, dc_form *out, std::vector<int> *postfix)
+{
+    const dc_expr &ex = cl->ast->exprs[e];
+    const int n = cl->loop->count;
+    int slot;
+    switch (ex.op)
+    {
+    case INT_LIT:
+        constant(out, n, (u64)ex.value, false);
+        return true;
+    case INC_OP:
+    case DEC_OP:
+        postfix->push_back(e);
+    // fall through: the value is the old one
+    case IDENT:
+        slot = slotOf(cl->loop, ex.symbol);
+        if (slot >= 0)
+            *out = cl->state[slot];
+        else
+            constant(out, n, cl->vars ? (u64)cl->vars[ex.symbol] : 0, cl->vars == nullptr);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Operator ex applied to the values of its operands a and b. False
+ *  when the result is not affine
+ */
+static bool evalOp(dc_closer *cl, const dc_expr &ex, dc_form a, dc_form b, dc_form *out)
+{
+    const int n = cl->loop->count;
+    switch (ex.op)
+    {
+    case ADD_OP:
+    case SUB_OP:
+        for (int j = 0; j <= n; j++)
+        {
+            out->c[j] = ex.op == ADD_OP ? a.c[j] + b.c[j] : a.c[j] - b.c[j];
+            out->unknown[j] = a.unknown[j] | b.unknown[j];
+        }
+        return true;
+    case MULT_OP:
+        if (!invariant(a, n) && !invariant(b, n))
+        {
+            cl->bad = ex.offset;
+            cl->why = "multiplies two values the loop changes";
+            return false;
+        }
+        if (!invariant(a, n))
+            std::swap(a, b);
+        // a is a constant factor; a known zero clears everything
+        for (int j = 0; j <= n; j++)
+        {
+            out->c[j] = a.c[n] * b.c[j];
+            out->unknown[j] = (a.unknown[n] && (b.c[j] != 0 || b.unknown[j])) ||
+                              (b.unknown[j] && (a.c[n] != 0 || a.unknown[n]));
+        }
+        return true;
+    }
+
+    // division and comparison only of values the loop does not change
+    if (!invariant(a, n) || !invariant(b, n))
+    {
+        cl->bad = ex.offset;
+        cl->why = ex.op == DIV_OP ? "divides a value the loop changes"
+                                  : "compares a value the loop changes";
+        return false;
+    }
+    if (a.unknown[n] || b.unknown[n])
+    {
+        constant(out, n, 0, true);
+        return true;
+    }
+    long long x = (long long)a.c[n], y = (long long)b.c[n];
+    if (ex.op != DIV_OP)
+        constant(out, n, compare(ex.op, x, y), false);
+    else if (y == 0)
+    {
+        // stepping reports the error at the right place
+        cl->bad = ex.offset;
+        cl->why = "divides by zero";
+        return false;
+    }
+    else
+        constant(out, n, y == -1 ? 0 - (u64)x : (u64)(x / y), false);
+    return true;
+}
+
+/**
+ * @brief Evaluate expression e into *out, operands left first; postfix
+ *  operators are collected for the end of the statement. False when e is
+ *  not affine
+ */
+static bool evalExpr(dc_closer *cl, int e, dc_form *out, std::vector<int> *postfix)
+{
+    if (evalLeaf(cl, e, out, postfix))
+        return true;
+    cl->work.assign(1, std::make_pair(e, false));
+    cl->values.clear();
+    while (!cl->work.empty())
+    {
+        std::pair<int, bool> top = cl->work.back();
+        cl->work.pop_back();
+        const dc_expr &ex = cl->ast->exprs[top.first];
+        dc_form value;
+        if (evalLeaf(cl, top.first, &value, postfix))
+            cl->values.push_back(value);
+        else if (!top.second)
+        {
+            cl->work.push_back(std::make_pair(top.first, true));
+            cl->work.push_back(std::make_pair(ex.right, false));
+            cl->work.push_back(std::make_pair(ex.left, false));
+        }
+        else
+        {
+            dc_form b = cl->values.back();
+            cl->values.pop_back();
+            if (!evalOp(cl, ex, cl->values.back(), b, &value))
+                return false;
+            cl->values.back() = value;
+        }
+    }
+    *out = cl->values.back();
+    return true;
+}
+
+static void applyPostfix(dc_closer *cl, const std::vector<int> &postfix)
+{
+    for (size_t i = 0; i < postfix.size(); i++)
+    {
+        const dc_expr &ex = cl->ast->exprs[postfix[i]];
+        cl->state[slotOf(cl->loop, ex.symbol)].c[cl->loop->count] += ex.op == INC_OP ? 1 : -1;
+    }
+}
+
+/**
+ * @brief One iteration of the loop: cl->state becomes x' = A x + b and
+ *  the sides of the condition are filled in
+ */
+static bool iterate(dc_closer *cl)
+{
+    const dc_stmt &loop = cl->ast->stmts[cl->loop->stmt];
+    const int n = cl->loop->count;
+    std::vector<int> postfix;
+    cl->bad = NO_OFFSET;
+    for (int i = 0; i < n; i++)
+    {
+        constant(&cl->state[i], n, 0, false);
+        cl->state[i].c[i] = 1;
+    }
+    for (int s = loop.body; s >= 0; s = cl->ast->stmts[s].next)
+    {
+        const dc_stmt &st = cl->ast->stmts[s];
+        dc_form value;
+        postfix.clear();
+        if (!evalExpr(cl, st.expr, &value, &postfix))
+            return false;
+        cl->state[slotOf(cl->loop, st.symbol)] = value;
+        applyPostfix(cl, postfix);
+    }
+
+    postfix.clear();
+    const dc_expr &cond = cl->ast->exprs[loop.cond];
+    if (isComparison(cond.op))
+    {
+        cl->test = cond.op;
+        if (!evalExpr(cl, cond.left, &cl->left, &postfix) ||
+            !evalExpr(cl, cond.right, &cl->right, &postfix))
+            return false;
+    }
+    else
+    {
+        // while (e) is while (e != 0)
+        cl->test = NEQUAL_OP;
+        if (!evalExpr(cl, loop.cond, &cl->left, &postfix))
+            return false;
+        constant(&cl->right, n, 0, false);
+    }
+    applyPostfix(cl, postfix);
+    return true;
+}
+
+/**
+ * @brief The shape check: a body of assignments, few enough loop
+ *  variables, affine values. On failure *why and *at say what is in the
+ *  way (*at is NO_OFFSET when it is the loop as a whole)
+ */
+static bool analyse(const dc_ast *ast, int s, dc_loopform *loop, dc_closer *cl, const char **why,
+                    size_t *at)
+{
+    const dc_stmt &st = ast->stmts[s];
+    *at = NO_OFFSET;
+    for (int b = st.body; b >= 0; b = ast->stmts[b].next)
+    {
+        switch (ast->stmts[b].kind)
+        {
+        case KEY_DO:
+            *why = "its body contains a loop";
+            return false;
+        case KEY_PAR:
+            *why = "its body contains a par";
+            return false;
+        case KEY_READ:
+            *why = "its body reads input";
+            return false;
+        case KEY_WRITE:
+            *why = "its body writes output";
+            return false;
+        }
+    }
+
+    std::vector<int> writes;
+    collectWrites(ast, s, &writes);
+    std::sort(writes.begin(), writes.end());
+    writes.erase(std::unique(writes.begin(), writes.end()), writes.end());
+    if (writes.size() > MAX_IVS)
+    {
+        *why = "it changes more than 8 variables";
+        return false;
+    }
+    loop->stmt = s;
+    loop->count = (int)writes.size();
+    std::copy(writes.begin(), writes.end(), loop->vars);
+
+    cl->ast = ast;
+    cl->loop = loop;
+    cl->vars = nullptr;
+    if (!iterate(cl))
+    {
+        *why = cl->why;
+        *at = cl->bad;
+        return false;
+    }
+    return true;
+}
+
+bool loopForm(const dc_ast *ast, int s, dc_loopform *loop)
+{
+    dc_closer cl;
+    const char *why;
+    size_t at;
+    return analyse(ast, s, loop, &cl, &why, &at);
+}
+
+/**
+ * @brief r = p q for (n+1) x (n+1) matrices, mod 2^64
+ */
+static void multiply(const u64 *p, const u64 *q, u64 *r, int n)
+{
+    const int m = n + 1;
+    for (int i = 0; i < m; i++)
+        for (int j = 0; j < m; j++)
+        {
+            u64 sum = 0;
+            for (int k = 0; k < m; k++)
+                sum += p[i * m + k] * q[k * m + j];
+            r[i * m + j] = sum;
+        }
+}
+
+/**
+ * @brief Whether the side of the condition with coefficients g moves by
+ *  the same amount every iteration: g A = g
+ */
+static bool steady(const dc_closer *cl, const dc_form &g)
+{
+    const int n = cl->loop->count;
+    for (int j = 0; j < n; j++)
+    {
+        u64 sum = 0;
+        for (int i = 0; i < n; i++)
+            sum += g.c[i] * cl->state[i].c[j];
+        if (sum != g.c[j])
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Value of f at x (the loop variables on entry) and its change
+ *  per iteration
+ */
+static void track(const dc_closer *cl, const dc_form &f, const u64 *x, i128 *start, i128 *step)
+{
+    const int n = cl->loop->count;
+    u64 v = f.c[n], d = 0;
+    for (int i = 0; i < n; i++)
+    {
+        v += f.c[i] * x[i];
+        d += f.c[i] * cl->state[i].c[n];
+    }
+    *start = (long long)v;
+    *step = (long long)d;
+}
+
+/**
+ * @brief How many times the condition holds before it first fails, when
+ *  its sides are exact integers start + k step; false if it never fails
+ */
+static bool tripCount(int test, i128 diff, i128 step, i128 *k)
+{
+    if (!compare(test, diff > 0 ? 1 : diff < 0 ? -1 : 0, 0))
+    {
+        *k = 0;
+        return true;
+    }
+    switch (test)
+    {
+    case LESSER_OP: // diff + k step >= 0
+        if (step <= 0)
+            return false;
+        *k = (-diff + step - 1) / step;
+        return true;
+    case GREATER_OP:
+        if (step >= 0)
+            return false;
+        *k = (diff - step - 1) / -step;
+        return true;
+    case LEQUAL_OP: // diff + k step > 0
+        if (step <= 0)
+            return false;
+        *k = -diff / step + 1;
+        return true;
+    case GEQUAL_OP:
+        if (step >= 0)
+            return false;
+        *k = diff / -step + 1;
+        return true;
+    case EQUAL_OP:
+        *k = 1;
+        return step != 0;
+    }
+    // != holds until diff hits 0 exactly
+    if (step == 0 || (diff > 0) == (step > 0) || diff % step != 0)
+        return false;
+    *k = -diff / step;
+    return true;
+}
+
+static bool inRange(i128 v)
+{
+    return v >= LLONG_MIN && v <= LLONG_MAX;
+}
+
+bool runClosed(const dc_ast *ast, const dc_loopform *loop, const long long *vars, long long *out)
+{
+    dc_closer cl;
+    cl.ast = ast;
+    cl.loop = loop;
+    cl.vars = vars;
+    if (!iterate(&cl) || !steady(&cl, cl.left) || !steady(&cl, cl.right))
+        return false;
+
+    const int n = loop->count, m = n + 1;
+    u64 x[MAX_IVS + 1];
+    for (int i = 0; i < n; i++)
+        x[i] = (u64)vars[loop->vars[i]];
+    x[n] = 1;
+
+    // both sides are linear in the iteration count while neither wraps
+    i128 l0, ls, r0, rs, k;
+    track(&cl, cl.left, x, &l0, &ls);
+    track(&cl, cl.right, x, &r0, &rs);
+    if (!tripCount(cl.test, l0 - r0, ls - rs, &k) || k > (i128)ULLONG_MAX ||
+        !inRange(l0 + k * ls) || !inRange(r0 + k * rs))
+        return false;
+
+    // the body runs k + 1 times: x = M^(k+1) x, with M = [A b; 0 1]
+    u64 power[(MAX_IVS + 1) * (MAX_IVS + 1)], square[(MAX_IVS + 1) * (MAX_IVS + 1)];
+    for (int i = 0; i < m; i++)
+        for (int j = 0; j < m; j++)
+            power[i * m + j] = i < n ? cl.state[i].c[j] : j == n;
+    unsigned __int128 e = (unsigned __int128)k + 1;
+    while (e != 0)
+    {
+        if (e & 1)
+        {
+            u64 y[MAX_IVS + 1];
+            for (int i = 0; i < m; i++)
+            {
+                y[i] = 0;
+                for (int j = 0; j < m; j++)
+                    y[i] += power[i * m + j] * x[j];
+            }
+            std::copy(y, y + m, x);
+        }
+        e >>= 1;
+        if (e != 0)
+        {
+            multiply(power, power, square, n);
+            std::copy(square, square + m * m, power);
+        }
+    }
+    for (int i = 0; i < n; i++)
+        out[i] = (long long)x[i];
+    return true;
+}
+
+/**
+ * @brief How loop variable i changes per iteration, for the note
+ */
+static std::string describe(const dc_context *ctx, const dc_closer &cl, int i)
+{
+    const int n = cl.loop->count;
+    const dc_form &f = cl.state[i];
+    std::string name = dc_symbol_name(ctx, cl.loop->vars[i]);
+    bool others = false;
+    for (int j = 0; j < n; j++)
+        if (j != i && (f.c[j] != 0 || f.unknown[j]))
+            others = true;
+    if (f.unknown[i] || (f.c[i] != 0 && f.c[i] != 1))
+        return name + " scales";
+    if (f.c[i] == 0)
+        return name + " is recomputed";
+    if (others)
+        return name + " accumulates";
+    if (f.unknown[n])
+        return name + " += invariant";
+    long long step = (long long)f.c[n];
+    if (step < 0)
+        return name + " -= " + std::to_string(0 - (u64)step);
+    return name + " += " + std::to_string(step);
+}
+
+static void closeLoop(dc_context *ctx, int s, std::vector<dc_diag_rec> *notes, int *made)
+{
+    dc_loopform loop;
+    dc_closer cl;
+    const char *why = "";
+    size_t bad;
+    std::string at;
+    dc_diag_rec d;
+    where(ctx, ctx->ast.stmts[s].offset, &at);
+    d.kind = DC_DIAG_NOTE;
+    d.offset = ctx->ast.stmts[s].offset;
+    d.lexBefore = 0;
+    if (analyse(&ctx->ast, s, &loop, &cl, &why, &bad))
+    {
+        d.message = "note: do-while" + at + " has a closed form:";
+        for (int i = 0; i < loop.count; i++)
+            d.message += (i ? ", " : " ") + describe(ctx, cl, i);
+        (*made)++;
+    }
+    else
+    {
+        d.message = "note: do-while" + at + " is stepped: ";
+        if (bad != NO_OFFSET)
+        {
+            std::string there;
+            where(ctx, bad, &there);
+            d.message += "the expression" + there + " ";
+        }
+        d.message += why;
+    }
+    notes->push_back(d);
+}
+
+/**
+ * @brief Try every loop from statement s on, each before the loops inside
+ *  it
+ */
+static void closeList(dc_context *ctx, int s, std::vector<dc_diag_rec> *notes, int *made)
+{
+    std::vector<int> work(1, s); // statements still to visit, with what follows them
+    while (!work.empty())
+    {
+        s = work.back();
+        work.pop_back();
+        if (s < 0)
+            continue;
+        const dc_stmt &st = ctx->ast.stmts[s];
+        work.push_back(st.next);
+        // do { ... } while (0) from dc_parallelize runs once
+        if (st.kind == KEY_DO && !(ctx->ast.exprs[st.cond].op == INT_LIT &&
+                                   ctx->ast.exprs[st.cond].value == 0))
+            closeLoop(ctx, s, notes, made);
+        work.push_back(st.body);
+    }
+}
+
+int dc_close_loops(dc_context *ctx)
+{
+    if (ctx->exit_code != NoError)
+        return 0;
+    std::vector<dc_diag_rec> notes;
+    int made = 0;
+    closeList(ctx, ctx->ast.first, &notes, &made);
+    for (size_t i = 0; i < notes.size(); i++)
+        report(ctx, notes[i].kind, notes[i].message, notes[i].offset);
+    ctx->closedForms = true;
+    return made;
+}
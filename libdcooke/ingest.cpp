@@ -0,0 +1,523 @@
+/*
+=============================================================================
+Title : ingest.cpp
+Description : Batch file ingestion for corpus validation (dc_ingest).
+Author : silrodri (R#11679913)
+Date : 10/19/2026
+Version : 2.0
+Usage : Built into libdcooke; see dc_ingest() in dcooke.h
+Notes : On Linux the calling thread drives an io_uring: opens, reads and
+        closes for many files are queued and submitted together with one
+        io_uring_enter, and each finished buffer is handed to a pool of
+        worker threads. At most LOADED_PER_WORKER files per worker are
+        open or loaded and not yet parsed; past that the ingest thread
+        waits for the parsers before it opens more. Elsewhere, or when the kernel refuses the ring, the
+        workers fall back to blocking fopen/fread/fclose.
+C++ Version : cpp (GCC) 4.8.5 20150623 (Red Hat 4.8.5-16)
+=============================================================================
+*/
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <stdint.h>
+#include <thread>
+#include <vector>
+
+// build with -DDC_NO_URING where <linux/io_uring.h> is unavailable
+#if defined(__linux__) && !defined(DC_NO_URING)
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define DC_HAVE_URING 1
+#endif
+
+#include "dcooke.h"
+
+#define LOADED_PER_WORKER 8 // files held between open and parse, per worker
+
+/**
+ * @brief : A file whose contents are ready for a parser worker
+ */
+struct dc_loaded
+{
+    size_t index;
+    char *data; // malloc'd, freed after the callback
+    size_t len;
+    int err;
+};
+
+/**
+ * @brief : Queue between the ingest thread and the parser workers; live
+ *  counts files claimed by claim() whose callback has not finished
+ */
+struct dc_handoff
+{
+    std::mutex lock;
+    std::condition_variable ready, drained;
+    std::deque<dc_loaded> items;
+    size_t live, limit;
+    bool closed;
+};
+
+/**
+ * @brief Wait until fewer than limit files are held, then hold one more
+ */
+static void claim(dc_handoff *q)
+{
+    std::unique_lock<std::mutex> hold(q->lock);
+    while (q->live >= q->limit)
+        q->drained.wait(hold);
+    q->live++;
+}
+
+/**
+ * @brief claim() without the wait; false when no slot is free
+ */
+static bool tryClaim(dc_handoff *q)
+{
+    std::lock_guard<std::mutex> hold(q->lock);
+    if (q->live >= q->limit)
+        return false;
+    q->live++;
+    return true;
+}
+
+/**
+ * @brief Parser worker: run the callback on loaded files until the queue closes
+ */
+static void consume(dc_handoff *q, unsigned worker, dc_ingest_fn fn, void *user)
+{
+    for (;;)
+    {
+        dc_loaded item;
+        {
+            std::unique_lock<std::mutex> hold(q->lock);
+            while (q->items.empty() && !q->closed)
+                q->ready.wait(hold);
+            if (q->items.empty())
+                return;
+            item = q->items.front();
+            q->items.pop_front();
+        }
+        fn(user, worker, item.index, item.data, item.len, item.err);
+        free(item.data);
+        {
+            std::lock_guard<std::mutex> hold(q->lock);
+            q->live--;
+        }
+        q->drained.notify_one();
+    }
+}
+
+/**
+ * @brief Hand a loaded file to the workers
+ */
+static void publish(dc_handoff *q, size_t index, char *data, size_t len, int err)
+{
+    dc_loaded item;
+    item.index = index;
+    item.data = data;
+    item.len = len;
+    item.err = err;
+    {
+        std::lock_guard<std::mutex> hold(q->lock);
+        q->items.push_back(item);
+    }
+    q->ready.notify_one();
+}
+
+/**
+ * @brief Read a whole file with stdio; returns errno-style status
+ */
+static int readWhole(const char *path, char **data, size_t *len)
+{
+    FILE *fp = fopen(path, "rb");
+    size_t cap = 4096, n;
+
+    *data = nullptr;
+    *len = 0;
+    if (fp == nullptr)
+        return errno;
+    *data = (char *)malloc(cap);
+    while (*data != nullptr && (n = fread(*data + *len, 1, cap - *len, fp)) > 0)
+    {
+        *len += n;
+        if (*len == cap)
+        {
+            char *grown = (char *)realloc(*data, cap *= 2);
+            if (grown == nullptr)
+                free(*data);
+            *data = grown;
+        }
+    }
+    fclose(fp);
+    if (*data == nullptr)
+    {
+        *len = 0;
+        return ENOMEM;
+    }
+    return 0;
+}
+
+#ifdef DC_HAVE_URING
+
+#define RING_ENTRIES 256
+#define FIRST_READ 65536
+
+/* What the single in-flight operation of a job is doing */
+#define OP_OPEN 0
+#define OP_READ 1
+#define OP_CLOSE 2
+
+/**
+ * @brief : One file moving through open -> read(s) -> close on the ring
+ */
+struct dc_job
+{
+    size_t index;
+    int op;
+    int fd;
+    int err;
+    char *data;
+    size_t len;
+    size_t cap;
+    bool published;
+};
+
+/**
+ * @brief : Mapped submission / completion queues of one io_uring
+ */
+struct dc_ring
+{
+    int fd;
+    unsigned *sqHead, *sqTail, *sqMask, *sqArray;
+    unsigned *cqHead, *cqTail, *cqMask;
+    io_uring_sqe *sqes;
+    io_uring_cqe *cqes;
+    void *sqMap, *cqMap;
+    size_t sqMapLen, cqMapLen, sqesLen;
+    unsigned pending; // queued but not yet submitted
+};
+
+/**
+ * @brief Unmap the queues and close the ring
+ */
+static void ringClose(dc_ring *r)
+{
+    munmap(r->sqes, r->sqesLen);
+    if (r->cqMap != r->sqMap)
+        munmap(r->cqMap, r->cqMapLen);
+    munmap(r->sqMap, r->sqMapLen);
+    close(r->fd);
+}
+
+/**
+ * @brief Create the ring and check the kernel supports open/read/close ops
+ */
+static bool ringOpen(dc_ring *r)
+{
+    io_uring_params p;
+    memset(&p, 0, sizeof p);
+    r->fd = (int)syscall(__NR_io_uring_setup, RING_ENTRIES, &p);
+    if (r->fd < 0)
+        return false;
+
+    r->sqMapLen = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    r->cqMapLen = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+    if (p.features & IORING_FEAT_SINGLE_MMAP)
+        r->sqMapLen = r->cqMapLen = std::max(r->sqMapLen, r->cqMapLen);
+    r->sqMap = mmap(nullptr, r->sqMapLen, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, r->fd, IORING_OFF_SQ_RING);
+    r->cqMap = (p.features & IORING_FEAT_SINGLE_MMAP)
+                   ? r->sqMap
+                   : mmap(nullptr, r->cqMapLen, PROT_READ | PROT_WRITE,
+                          MAP_SHARED | MAP_POPULATE, r->fd, IORING_OFF_CQ_RING);
+    r->sqesLen = p.sq_entries * sizeof(io_uring_sqe);
+    r->sqes = (io_uring_sqe *)mmap(nullptr, r->sqesLen, PROT_READ | PROT_WRITE,
+                                   MAP_SHARED | MAP_POPULATE, r->fd, IORING_OFF_SQES);
+    if (r->sqMap == MAP_FAILED || r->cqMap == MAP_FAILED || r->sqes == MAP_FAILED)
+    {
+        close(r->fd);
+        return false;
+    }
+
+    char *sq = (char *)r->sqMap, *cq = (char *)r->cqMap;
+    r->sqHead = (unsigned *)(sq + p.sq_off.head);
+    r->sqTail = (unsigned *)(sq + p.sq_off.tail);
+    r->sqMask = (unsigned *)(sq + p.sq_off.ring_mask);
+    r->sqArray = (unsigned *)(sq + p.sq_off.array);
+    r->cqHead = (unsigned *)(cq + p.cq_off.head);
+    r->cqTail = (unsigned *)(cq + p.cq_off.tail);
+    r->cqMask = (unsigned *)(cq + p.cq_off.ring_mask);
+    r->cqes = (io_uring_cqe *)(cq + p.cq_off.cqes);
+    r->pending = 0;
+
+    // kernels before 5.6 lack the opcodes used here
+    std::vector<char> buf(sizeof(io_uring_probe) + 256 * sizeof(io_uring_probe_op), 0);
+    io_uring_probe *probe = (io_uring_probe *)&buf[0];
+    bool ok = syscall(__NR_io_uring_register, r->fd, IORING_REGISTER_PROBE, probe, 256) == 0;
+    const int ops[] = {IORING_OP_OPENAT, IORING_OP_READ, IORING_OP_CLOSE};
+    for (int i = 0; ok && i < 3; i++)
+        ok = ops[i] <= probe->last_op && (probe->ops[ops[i]].flags & IO_URING_OP_SUPPORTED);
+    if (!ok)
+        ringClose(r);
+    return ok;
+}
+
+/**
+ * @brief Claim the next submission slot (the caller keeps in-flight ops
+ *  below RING_ENTRIES, so a slot is always free)
+ */
+static io_uring_sqe *ringSqe(dc_ring *r, dc_job *job, int op)
+{
+    unsigned tail = *r->sqTail + r->pending;
+    unsigned idx = tail & *r->sqMask;
+    io_uring_sqe *sqe = &r->sqes[idx];
+    memset(sqe, 0, sizeof *sqe);
+    sqe->user_data = (unsigned long long)(uintptr_t)job;
+    r->sqArray[idx] = idx;
+    r->pending++;
+    job->op = op;
+    return sqe;
+}
+
+/**
+ * @brief Publish queued SQEs and wait for at least 'wait' completions
+ */
+static int ringEnter(dc_ring *r, unsigned wait)
+{
+    __atomic_store_n(r->sqTail, *r->sqTail + r->pending, __ATOMIC_RELEASE);
+    unsigned submit = r->pending;
+    r->pending = 0;
+    int ret;
+    do
+        ret = (int)syscall(__NR_io_uring_enter, r->fd, submit, wait,
+                           wait ? IORING_ENTER_GETEVENTS : 0, nullptr, 0);
+    while (ret < 0 && errno == EINTR);
+    return ret;
+}
+
+static void queueRead(dc_ring *r, dc_job *job)
+{
+    io_uring_sqe *sqe = ringSqe(r, job, OP_READ);
+    sqe->opcode = IORING_OP_READ;
+    sqe->fd = job->fd;
+    sqe->addr = (unsigned long long)(uintptr_t)(job->data + job->len);
+    sqe->len = (unsigned)(job->cap - job->len);
+    sqe->off = job->len;
+}
+
+static void queueClose(dc_ring *r, dc_job *job)
+{
+    io_uring_sqe *sqe = ringSqe(r, job, OP_CLOSE);
+    sqe->opcode = IORING_OP_CLOSE;
+    sqe->fd = job->fd;
+}
+
+/**
+ * @brief The ring failed: close what it left open and read every file it
+ *  had not published with plain reads. Files the ring opened already hold
+ *  a slot; the rest claim one before they are read
+ */
+static void ingestRest(std::vector<dc_job> &jobs, size_t started, const char *const *paths,
+                       dc_handoff *q)
+{
+    for (size_t i = 0; i < jobs.size(); i++)
+    {
+        dc_job *job = &jobs[i];
+        if (job->published)
+            continue;
+        if (i < started)
+        {
+            // a queued close may have gone in already; closing again could
+            // hit an fd reused since
+            if (job->fd >= 0 && job->op != OP_CLOSE)
+                close(job->fd);
+            // a read in flight may still land in data, so that one is leaked
+            if (job->op != OP_READ)
+                free(job->data);
+        }
+        else
+            claim(q);
+        char *data;
+        size_t len;
+        int err = readWhole(paths[i], &data, &len);
+        publish(q, i, data, len, err);
+    }
+}
+
+/**
+ * @brief Drive every path through the ring, publishing finished files
+ */
+static void ingestUring(dc_ring *r, const char *const *paths, size_t count, dc_handoff *q)
+{
+    std::vector<dc_job> jobs(count);
+    size_t next = 0;     // next path to open
+    unsigned flight = 0; // ops submitted and not yet completed
+
+    while (next < count || flight + r->pending > 0)
+    {
+        // top up with opens while there is room in the ring and the parsers
+        // keep up; with nothing else to wait for, wait for them
+        while (next < count && flight + r->pending < RING_ENTRIES)
+        {
+            if (flight + r->pending == 0)
+                claim(q);
+            else if (!tryClaim(q))
+                break;
+            dc_job *job = &jobs[next];
+            job->index = next++;
+            job->fd = -1;
+            job->err = 0;
+            job->data = nullptr;
+            job->len = job->cap = 0;
+            job->published = false;
+            io_uring_sqe *sqe = ringSqe(r, job, OP_OPEN);
+            sqe->opcode = IORING_OP_OPENAT;
+            sqe->fd = AT_FDCWD;
+            sqe->addr = (unsigned long long)(uintptr_t)paths[job->index];
+            sqe->open_flags = O_RDONLY | O_CLOEXEC;
+        }
+        flight += r->pending;
+        if (ringEnter(r, 1) < 0)
+        {
+            ingestRest(jobs, next, paths, q);
+            return;
+        }
+
+        unsigned head = *r->cqHead;
+        while (head != __atomic_load_n(r->cqTail, __ATOMIC_ACQUIRE))
+        {
+            io_uring_cqe *cqe = &r->cqes[head++ & *r->cqMask];
+            dc_job *job = (dc_job *)(uintptr_t)cqe->user_data;
+            int res = cqe->res;
+            flight--;
+
+            switch (job->op)
+            {
+            case OP_OPEN:
+                if (res < 0)
+                {
+                    job->published = true;
+                    publish(q, job->index, nullptr, 0, -res);
+                    break;
+                }
+                job->fd = res;
+                job->cap = FIRST_READ;
+                job->data = (char *)malloc(job->cap);
+                if (job->data == nullptr)
+                {
+                    job->err = ENOMEM;
+                    queueClose(r, job);
+                }
+                else
+                    queueRead(r, job);
+                break;
+            case OP_READ:
+                if (res < 0)
+                {
+                    job->err = -res;
+                    queueClose(r, job);
+                    break;
+                }
+                job->len += (size_t)res;
+                // a full buffer may mean more data: grow and keep reading
+                if (res > 0 && job->len == job->cap)
+                {
+                    char *grown = (char *)realloc(job->data, job->cap *= 2);
+                    if (grown == nullptr)
+                    {
+                        job->err = ENOMEM;
+                        queueClose(r, job);
+                        break;
+                    }
+                    job->data = grown;
+                    queueRead(r, job);
+                }
+                else
+                    queueClose(r, job);
+                break;
+            case OP_CLOSE:
+                if (job->err != 0)
+                {
+                    free(job->data);
+                    job->data = nullptr;
+                    job->len = 0;
+                }
+                job->published = true;
+                publish(q, job->index, job->data, job->len, job->err);
+                break;
+            }
+        }
+        __atomic_store_n(r->cqHead, head, __ATOMIC_RELEASE);
+    }
+}
+
+#endif /* DC_HAVE_URING */
+
+/**
+ * @brief Fallback worker: blocking reads, then the callback, for each path
+ *  claimed from the shared counter
+ */
+static void readAndConsume(const char *const *paths, size_t count, std::atomic<size_t> *next,
+                           unsigned worker, dc_ingest_fn fn, void *user)
+{
+    size_t i;
+    while ((i = next->fetch_add(1)) < count)
+    {
+        char *data;
+        size_t len;
+        int err = readWhole(paths[i], &data, &len);
+        fn(user, worker, i, data, len, err);
+        free(data);
+    }
+}
+
+int dc_ingest(const char *const *paths, size_t count, unsigned workers,
+              dc_ingest_backend backend, dc_ingest_fn fn, void *user)
+{
+    std::vector<std::thread> pool;
+
+    if (workers == 0)
+        workers = std::max(1u, std::thread::hardware_concurrency());
+
+#ifdef DC_HAVE_URING
+    dc_ring ring;
+    if (backend != DC_INGEST_THREADS && ringOpen(&ring))
+    {
+        dc_handoff q;
+        q.closed = false;
+        q.live = 0;
+        q.limit = (size_t)workers * LOADED_PER_WORKER;
+        for (unsigned w = 0; w < workers; w++)
+            pool.push_back(std::thread(consume, &q, w, fn, user));
+        ingestUring(&ring, paths, count, &q);
+        {
+            std::lock_guard<std::mutex> hold(q.lock);
+            q.closed = true;
+        }
+        q.ready.notify_all();
+        for (size_t w = 0; w < pool.size(); w++)
+            pool[w].join();
+        ringClose(&ring);
+        return DC_INGEST_URING;
+    }
+#endif
+    if (backend == DC_INGEST_URING)
+        return -1;
+
+    std::atomic<size_t> next(0);
+    for (unsigned w = 0; w < workers; w++)
+        pool.push_back(std::thread(readAndConsume, paths, count, &next, w, fn, user));
+    for (size_t w = 0; w < pool.size(); w++)
+        pool[w].join();
+    return DC_INGEST_THREADS;
+}
@@ -0,0 +1,362 @@
+/*
+=============================================================================
+Title : lanes.cpp
+Description : Batched execution of one program over many inputs
+              (dc_run_batch).
+Author : silrodri (R#11679913)
+Date : 10/19/2026
+Version : 2.0
+Usage : Built into libdcooke; run after a successful dc_parse()
+Notes : Rows run in blocks of LANES. Every variable and stack slot holds
+        one value per lane, and each opcode is one dispatch followed by a
+        straight loop over the lanes, which the compiler turns into SIMD
+        code. Lanes leave a do-while at different times, so an active mask
+        is kept. A loop saves the mask it was entered with, keeps only the
+        lanes whose condition holds while any lane continues, and restores
+        the saved mask (minus failed rows) when none does. par branches
+        run one after another with the same snapshot/merge rule as dc_run.
+C++ Version : cpp (GCC) 4.8.5 20150623 (Red Hat 4.8.5-16)
+=============================================================================
+*/
+#include <climits>
+#include <cstring>
+
+#include "context.h"
+#include "exec.h"
+
+#define LANES 64
+
+typedef long long dc_lane[LANES];
+
+struct dc_lanes
+{
+    const dc_program *prog;
+    const dc_context *ctx;
+    std::vector<int> heads; // number of do-while loops starting at each pc
+    std::vector<int> inner; // per JNZ: loops sharing its head nested in it
+
+    /* inputs and outputs of dc_run_batch */
+    const long long *inputs;
+    size_t rows, columns;
+    const size_t *counts;
+    dc_batch_write_fn out;
+    void *user;
+    exitCode *status;
+    size_t failedRows;
+    size_t firstRow; // lowest failed row, its message around the position
+    std::string firstError, firstTail;
+    size_t firstAt; // of this source offset
+
+    /* the block of rows being run */
+    size_t base;
+    std::vector<long long> vars; // symbol * LANES + lane
+    std::vector<char> written;
+    std::vector<int> dirty;
+    dc_lane alive; // -1 until the row fails
+    dc_lane readAt;
+    std::vector<long long> stack;
+};
+
+/**
+ * @brief Stop one row on a runtime error; the summary puts the position
+ *  of offset between message and tail. A row only fails once
+ */
+static void failLane(dc_lanes *r, int lane, long long *mask, const std::string &message,
+                     size_t offset, const std::string &tail = "")
+{
+    size_t row = r->base + lane;
+    mask[lane] = 0;
+    if (!r->alive[lane])
+        return;
+    r->alive[lane] = 0;
+    r->failedRows++;
+    if (r->status)
+        r->status[row] = RuntimeError;
+    if (r->firstError.empty() || row < r->firstRow)
+    {
+        r->firstRow = row;
+        r->firstError = message;
+        r->firstTail = tail;
+        r->firstAt = offset;
+    }
+}
+
+/**
+ * @brief vars[sym] = v in the active lanes
+ */
+static void storeLanes(dc_lanes *r, int sym, const long long *v, const long long *mask)
+{
+    long long *dst = &r->vars[(size_t)sym * LANES];
+    for (int l = 0; l < LANES; l++)
+        dst[l] = (v[l] & mask[l]) | (dst[l] & ~mask[l]);
+    if (!r->written[sym])
+    {
+        r->written[sym] = 1;
+        r->dirty.push_back(sym);
+    }
+}
+
+static bool anyLane(const long long *mask)
+{
+    long long any = 0;
+    for (int l = 0; l < LANES; l++)
+        any |= mask[l];
+    return any != 0;
+}
+
+static void runLanes(dc_lanes *r, int pc, long long *mask);
+
+/**
+ * @brief Run the branches of a par in order on copies of the variables,
+ *  then merge what each assigned (a later branch wins). A row that fails
+ *  in one branch runs none of the later ones, as with dc_run
+ */
+static void parLanes(dc_lanes *r, const dc_par &par, const long long *mask)
+{
+    std::vector<long long> snapshot = r->vars;
+    std::vector<std::pair<int, std::vector<long long> > > merged;
+    dc_lane branchMask;
+
+    for (size_t i = 0; i < par.branches.size(); i++)
+    {
+        std::vector<char> written(r->written.size(), 0);
+        std::vector<int> dirty;
+        r->written.swap(written);
+        r->dirty.swap(dirty);
+        r->vars = snapshot;
+        for (int l = 0; l < LANES; l++)
+            branchMask[l] = mask[l] & r->alive[l];
+        runLanes(r, par.branches[i], branchMask);
+        for (size_t d = 0; d < r->dirty.size(); d++)
+        {
+            const long long *v = &r->vars[(size_t)r->dirty[d] * LANES];
+            merged.push_back(std::make_pair(r->dirty[d], std::vector<long long>(v, v + LANES)));
+        }
+        r->written.swap(written);
+        r->dirty.swap(dirty);
+    }
+    r->vars.swap(snapshot);
+    for (size_t m = 0; m < merged.size(); m++)
+        storeLanes(r, merged[m].first, merged[m].second.data(), mask);
+}
+
+/**
+ * @brief Run code from pc until DC_OP_END over the lanes in mask
+ */
+static void runLanes(dc_lanes *r, int pc, long long *mask)
+{
+    const dc_insn *code = r->prog->code.data();
+    std::vector<long long> loops; // entry mask of each open do-while
+    size_t sp = 2;                // stack depth in slots; 2 spare at the bottom
+    bool backEdge = false;
+
+    for (;;)
+    {
+        // entering a loop head saves the mask to restore when it exits
+        if (!backEdge)
+            for (int k = 0; k < r->heads[pc]; k++)
+                loops.insert(loops.end(), mask, mask + LANES);
+        backEdge = false;
+
+        const dc_insn &in = code[pc++];
+        if ((sp + 1) * LANES > r->stack.size())
+            r->stack.resize(r->stack.size() * 2);
+        long long *top = &r->stack[sp * LANES];  // next free slot
+        long long *a = top - 2 * LANES, *b = top - LANES;
+        const long long *v = r->vars.data();
+
+        switch (in.op)
+        {
+        case DC_OP_PUSH:
+            for (int l = 0; l < LANES; l++)
+                top[l] = in.imm;
+            sp++;
+            break;
+        case DC_OP_LOAD:
+            memcpy(top, v + (size_t)in.arg * LANES, sizeof(dc_lane));
+            sp++;
+            break;
+        case DC_OP_STORE:
+            storeLanes(r, in.arg, b, mask);
+            sp--;
+            break;
+        case DC_OP_ADD:
+            for (int l = 0; l < LANES; l++)
+                a[l] = (long long)((unsigned long long)a[l] + (unsigned long long)b[l]);
+            sp--;
+            break;
+        case DC_OP_SUB:
+            for (int l = 0; l < LANES; l++)
+                a[l] = (long long)((unsigned long long)a[l] - (unsigned long long)b[l]);
+            sp--;
+            break;
+        case DC_OP_MUL:
+            for (int l = 0; l < LANES; l++)
+                a[l] = (long long)((unsigned long long)a[l] * (unsigned long long)b[l]);
+            sp--;
+            break;
+        // no SIMD integer divide; inactive lanes divide by 1
+        case DC_OP_DIV:
+            for (int l = 0; l < LANES; l++)
+            {
+                if (mask[l] && b[l] == 0)
+                    failLane(r, l, mask, "Error - division by zero", in.offset);
+                long long d = mask[l] && b[l] != 0 ? b[l] : 1;
+                a[l] = d == -1 ? (long long)(0ULL - (unsigned long long)a[l]) : a[l] / d;
+            }
+            sp--;
+            break;
+        case DC_OP_LT:
+            for (int l = 0; l < LANES; l++)
+                a[l] = a[l] < b[l];
+            sp--;
+            break;
+        case DC_OP_GT:
+            for (int l = 0; l < LANES; l++)
+                a[l] = a[l] > b[l];
+            sp--;
+            break;
+        case DC_OP_LE:
+            for (int l = 0; l < LANES; l++)
+                a[l] = a[l] <= b[l];
+            sp--;
+            break;
+        case DC_OP_GE:
+            for (int l = 0; l < LANES; l++)
+                a[l] = a[l] >= b[l];
+            sp--;
+            break;
+        case DC_OP_EQ:
+            for (int l = 0; l < LANES; l++)
+                a[l] = a[l] == b[l];
+            sp--;
+            break;
+        case DC_OP_NE:
+            for (int l = 0; l < LANES; l++)
+                a[l] = a[l] != b[l];
+            sp--;
+            break;
+        case DC_OP_POST:
+            for (int l = 0; l < LANES; l++)
+                top[l] = (long long)((unsigned long long)v[in.arg * LANES + l] +
+                                     (unsigned long long)in.imm);
+            storeLanes(r, in.arg, top, mask);
+            break;
+        case DC_OP_READ:
+            for (int l = 0; l < LANES; l++)
+            {
+                if (!mask[l])
+                    continue;
+                size_t row = r->base + l;
+                size_t have = r->counts ? r->counts[row] : r->columns;
+                if ((size_t)r->readAt[l] >= have)
+                    failLane(r, l, mask,
+                             std::string("Error - read(") + dc_symbol_name(r->ctx, in.arg) + ")",
+                             in.offset, ": no more input");
+                else
+                    top[l] = r->inputs[r->readAt[l]++ * r->rows + row];
+            }
+            storeLanes(r, in.arg, top, mask);
+            break;
+        case DC_OP_WRITE:
+            for (int l = 0; l < LANES; l++)
+                if (mask[l] && r->out)
+                    r->out(r->user, r->base + l, v[in.arg * LANES + l]);
+            break;
+        case DC_OP_JNZ:
+            sp--;
+            for (int l = 0; l < LANES; l++)
+                top[l] = b[l] ? mask[l] & r->alive[l] : 0;
+            if (anyLane(top))
+            {
+                memcpy(mask, top, sizeof(dc_lane));
+                pc = in.arg;
+                backEdge = true;
+                // loops nested in this one that share its head start afresh
+                for (int k = 0; k < r->inner[&in - code]; k++)
+                    loops.insert(loops.end(), mask, mask + LANES);
+            }
+            else
+            {
+                for (int l = 0; l < LANES; l++)
+                    mask[l] = loops[loops.size() - LANES + l] & r->alive[l];
+                loops.resize(loops.size() - LANES);
+            }
+            break;
+        case DC_OP_JUMP:
+            pc = in.arg;
+            break;
+        case DC_OP_PAR:
+            parLanes(r, r->prog->pars[in.arg], mask);
+            for (int l = 0; l < LANES; l++)
+                mask[l] &= r->alive[l];
+            break;
+        case DC_OP_END:
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Execute the program of the last successful dc_parse once per row
+ */
+exitCode dc_run_batch(dc_context *ctx, const long long *inputs, size_t rows, size_t columns,
+                      const size_t *counts, dc_batch_write_fn write_fn, void *user,
+                      exitCode *status)
+{
+    if (ctx->exit_code != NoError)
+        return ctx->exit_code;
+
+    dc_program prog;
+    compileProgram(&ctx->ast, ctx->symbols.syms.size(), false, false, &prog);
+
+    dc_lanes *r = new dc_lanes();
+    r->prog = &prog;
+    r->ctx = ctx;
+    r->heads.assign(prog.code.size(), 0);
+    r->inner.assign(prog.code.size(), 0);
+    for (size_t pc = 0; pc < prog.code.size(); pc++)
+        if (prog.code[pc].op == DC_OP_JNZ)
+        {
+            // earlier JNZs to the same head close loops nested in this one
+            r->inner[pc] = r->heads[prog.code[pc].arg]++;
+        }
+    r->inputs = inputs;
+    r->rows = rows;
+    r->columns = columns;
+    r->counts = counts;
+    r->out = write_fn;
+    r->user = user;
+    r->status = status;
+    r->failedRows = 0;
+    r->stack.resize(32 * LANES);
+
+    for (r->base = 0; r->base < rows; r->base += LANES)
+    {
+        dc_lane mask;
+        r->vars.assign(prog.symbols * LANES, 0);
+        r->written.assign(prog.symbols, 0);
+        r->dirty.clear();
+        for (int l = 0; l < LANES; l++)
+        {
+            mask[l] = r->alive[l] = r->base + l < rows ? -1 : 0;
+            r->readAt[l] = 0;
+            if (status && r->base + l < rows)
+                status[r->base + l] = NoError;
+        }
+        runLanes(r, 0, mask);
+    }
+
+    if (r->failedRows > 0)
+    {
+        where(ctx, r->firstAt, &r->firstError);
+        report(ctx, DC_DIAG_RUNTIME,
+               "Error - " + std::to_string(r->failedRows) + " of " + std::to_string(rows) +
+                   " rows stopped; first, row " + std::to_string(r->firstRow) + ": " +
+                   r->firstError.substr(strlen("Error - ")) + r->firstTail,
+               r->firstAt);
+        ctx->exit_code = RuntimeError;
+    }
+    delete r;
+    return ctx->exit_code;
+}
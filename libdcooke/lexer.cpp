@@ -0,0 +1,210 @@
+/*
+=============================================================================
+Title : lexer.cpp
+Description : This is the lexical analyzer of libdcooke.
+Author : silrodri (R#11679913)
+Date : 10/19/2026
+Version : 2.0
+Usage : Built into libdcooke; driven by dc_tokenize() / dc_parse()
+Notes : Formerly duplicated in the main.cpp of Project 1 and Project 2. The
+        input is an in-memory buffer instead of a FILE *. Token rules live
+        in tokens.spec; lexgen compiles them into lexer_dfa.h.
+C++ Version : cpp (GCC) 4.8.5 20150623 (Red Hat 4.8.5-16)
+=============================================================================
+*/
+#include <cstring>
+#include <cstdio>
+#include <climits>
+#include <stdint.h>
+
+#include "context.h"
+#include "lexer_dfa.h"
+
+/* Local Function declarations */
+static void addChar(dc_context *ctx, char c);
+static void decodeIntLit(dc_context *ctx, size_t end);
+
+/*****************************************************/
+/* addChar - a function to add c to lexeme */
+static void addChar(dc_context *ctx, char c)
+{
+    if (ctx->limits.maxTokenLength && (size_t)ctx->lexLen >= ctx->limits.maxTokenLength)
+        limitExceeded(ctx, "token length", ctx->limits.maxTokenLength);
+    else if (ctx->lexLen <= 98)
+    {
+        ctx->lexeme[ctx->lexLen++] = c;
+        ctx->lexeme[ctx->lexLen] = 0;
+    }
+    else
+    {
+        std::string message = "Error - lexeme is too long";
+        where(ctx, ctx->tokenStart, &message);
+        report(ctx, DC_DIAG_LEXICAL, message, ctx->tokenStart);
+    }
+}
+
+/*****************************************************/
+/* eightDigits - convert 8 ASCII digits to their value with SWAR arithmetic
+ * (three multiply/shift rounds fold 1-digit lanes into 2, 4 and 8 digits) */
+static inline uint32_t eightDigits(const char *p)
+{
+    uint64_t v;
+    memcpy(&v, p, sizeof v);
+    v -= 0x3030303030303030ULL;
+    v = ((v & 0x0F0F0F0F0F0F0F0FULL) * ((10 << 8) + 1)) >> 8;
+    v = ((v & 0x00FF00FF00FF00FFULL) * ((100 << 16) + 1)) >> 16;
+    v = ((v & 0x0000FFFF0000FFFFULL) * ((10000ULL << 32) + 1)) >> 32;
+    return (uint32_t)v;
+}
+
+/*****************************************************/
+/* literalOutOfRange - saturate intValue and report the full literal text */
+static void literalOutOfRange(dc_context *ctx, const char *start, const char *stop)
+{
+    ctx->intValue = LLONG_MAX;
+    std::string message = "Error - integer literal " + std::string(start, stop);
+    where(ctx, ctx->tokenStart, &message);
+    message += " does not fit in 64 bits";
+    report(ctx, DC_DIAG_LEXICAL, message, ctx->tokenStart);
+}
+
+/*****************************************************/
+/* decodeIntLit - decode the digit run [tokenStart, end) of the source into
+ * intValue; literals above INT64_MAX saturate and raise a diagnostic */
+static void decodeIntLit(dc_context *ctx, size_t end)
+{
+    const char *start = &ctx->src[ctx->tokenStart];
+    const char *stop = &ctx->src[0] + end;
+    const char *p = start;
+    uint64_t v = 0;
+
+    // leading zeros do not count towards the 19 digits an int64 can hold
+    while (p < stop - 1 && *p == '0')
+        p++;
+    if (stop - p > 19)
+    {
+        literalOutOfRange(ctx, start, stop);
+        return;
+    }
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    for (; stop - p >= 8; p += 8)
+        v = v * 100000000ULL + eightDigits(p);
+#endif
+    for (; p < stop; p++)
+        v = v * 10 + (uint64_t)(*p - '0');
+    // 19 digits always fit in a uint64, so one compare catches overflow
+    if (v > (uint64_t)LLONG_MAX)
+    {
+        literalOutOfRange(ctx, start, stop);
+        return;
+    }
+    ctx->intValue = (long long)v;
+}
+
+/*****************************************************/
+/* lexBegin - rewind the input */
+void lexBegin(dc_context *ctx)
+{
+    ctx->pos = 0;
+    ctx->nextToken = 0;
+    ctx->strNextToken = "";
+}
+
+/*****************************************************/
+/* scan - find the next token, pulling input as needed: its start goes to
+ * tokenStart and pos moves past it. Returns its code, or EOF. The token
+ * is not recorded; lex() and dc_format() do that part */
+int scan(dc_context *ctx)
+{
+    const unsigned char *src = (const unsigned char *)ctx->src.data();
+    size_t end = ctx->src.size();
+    size_t at = ctx->pos;
+    size_t len;
+    int code = UNKNOWN;
+
+    for (;;)
+    {
+        while (at < end && dfaSkip[src[at]])
+            at++;
+        // out of input: pull the next chunk, unless a cap drained the input
+        if (at < end || ctx->pull == nullptr || ctx->exit_code == LimitExceeded ||
+            ctx->pull(ctx->pullUser, ctx) != 0)
+            break;
+        src = (const unsigned char *)ctx->src.data();
+        end = ctx->src.size();
+    }
+    ctx->tokenStart = at;
+    if (at == end)
+    {
+        ctx->pos = end;
+        return EOF;
+    }
+    // a byte that starts no token is a one-byte UNKNOWN
+    if ((len = dfaScan(src + at, src + end, &code)) == 0)
+        len = 1;
+    ctx->pos = at + len;
+    return code;
+}
+
+/*****************************************************/
+/* lex - a simple lexical analyzer for arithmetic expressions. The token
+ * boundaries come from the DFA generated out of tokens.spec */
+int lex(dc_context *ctx)
+{
+    if (ctx->ring != nullptr)
+        return takeToken(ctx);
+    ctx->lexLen = 0;
+    ctx->lexeme[0] = 0;
+    ctx->nextToken = scan(ctx);
+    if (ctx->nextToken == EOF)
+        strcpy(ctx->lexeme, "EOF");
+    else
+    {
+        const char *src = ctx->src.data();
+        size_t at = ctx->tokenStart, len = ctx->pos - at;
+        int code = ctx->nextToken;
+        // a cap hit mid-token drains the input and cuts the token there
+        size_t kept = 0;
+        while (kept < len && ctx->exit_code != LimitExceeded)
+            addChar(ctx, (char)src[at + kept++]);
+
+        if (code == IDENT)
+            // intern the full source slice, not the capped lexeme
+            ctx->symbol = symIntern(&ctx->symbols, ctx->src, at, kept);
+        else if (code == INT_LIT)
+            decodeIntLit(ctx, at + kept);
+    }
+
+    if (ctx->limits.maxTokens && ctx->nextToken != EOF &&
+        ctx->tokens.size() >= ctx->limits.maxTokens)
+    {
+        limitExceeded(ctx, "token count", ctx->limits.maxTokens);
+        ctx->nextToken = EOF;
+    }
+
+    // if not the end of file, record the lexeme and token, but always return
+    if (ctx->nextToken != EOF)
+    {
+        ctx->strNextToken = dc_token_name(ctx->nextToken); // update strNextToken
+        dc_token_rec tok;
+        tok.code = ctx->nextToken;
+        tok.lexemeAt = ctx->lexemes.size();
+        tok.offset = ctx->tokenStart;
+        tok.value = ctx->nextToken == INT_LIT ? ctx->intValue : 0;
+        tok.symbol = ctx->nextToken == IDENT ? ctx->symbol : -1;
+        ctx->tokens.push_back(tok);
+        ctx->lexemes.insert(ctx->lexemes.end(), ctx->lexeme,
+                            ctx->lexeme + ctx->lexLen + 1);
+    }
+    return ctx->nextToken;
+} /* End of function lex */
+
+/**
+ * @brief This function maps all the token identifiers (ints) -> string counterparts of their directives
+ *
+ * @param code -> token code, pass in nextToken
+ */
+const char *dc_token_name(int code)
+{
+    return dfaTokenName(code);
+}
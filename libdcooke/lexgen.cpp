@@ -0,0 +1,496 @@
+/*
+=============================================================================
+Title : lexgen.cpp
+Description : Build-time generator of the libdcooke scanner.
+Author : silrodri (R#11679913)
+Date : 10/19/2026
+Version : 2.0
+Usage : ./lexgen tokens.spec lexer_dfa.h (run by the makefile)
+Notes : spec -> Thompson NFA -> subset construction -> minimized DFA. The
+        output holds the byte classes, the transition table, and
+        dfaScan(), a direct-threaded (computed goto) longest-match scanner
+        with a table-driven fallback for compilers without labels as
+        values.
+C++ Version : cpp (GCC) 4.8.5 20150623 (Red Hat 4.8.5-16)
+=============================================================================
+*/
+#include <bitset>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+typedef std::bitset<256> byteSet;
+
+/**
+ * @brief : NFA node with at most one byte-set edge plus epsilon edges
+ */
+struct nfaNode
+{
+    byteSet on;
+    int to;
+    std::vector<int> eps;
+    int accept; // rule index, -1 if none
+};
+
+static std::vector<nfaNode> nfa;
+static std::vector<std::string> rules; // token name of each rule
+static byteSet skip;
+static const char *specPath;
+static int lineNo;
+
+static void fail(const std::string &msg)
+{
+    fprintf(stderr, "%s:%d: %s\n", specPath, lineNo, msg.c_str());
+    exit(1);
+}
+
+static int newNode()
+{
+    nfaNode n;
+    n.to = -1;
+    n.accept = -1;
+    nfa.push_back(n);
+    return (int)nfa.size() - 1;
+}
+
+/**
+ * @brief Read one (possibly escaped) pattern character at *p
+ */
+static unsigned char patChar(const char *&p)
+{
+    if (*p == 0)
+        fail("unterminated pattern");
+    if (*p != '\\')
+        return (unsigned char)*p++;
+    p++;
+    switch (*p++)
+    {
+    case 't':
+        return '\t';
+    case 'n':
+        return '\n';
+    case 'v':
+        return '\v';
+    case 'f':
+        return '\f';
+    case 'r':
+        return '\r';
+    case 0:
+        fail("dangling backslash");
+    }
+    return (unsigned char)p[-1];
+}
+
+/**
+ * @brief Parse [set] at *p (p on the '[')
+ */
+static byteSet parseSet(const char *&p)
+{
+    byteSet set;
+    bool negate = *++p == '^';
+    if (negate)
+        p++;
+    while (*p != ']')
+    {
+        unsigned char lo = patChar(p), hi = lo;
+        if (*p == '-' && p[1] != ']')
+        {
+            p++;
+            hi = patChar(p);
+        }
+        if (hi < lo)
+            fail("bad range in set");
+        for (int c = lo; c <= hi; c++)
+            set.set(c);
+    }
+    p++;
+    return negate ? ~set : set;
+}
+
+/**
+ * @brief Append one byte-set step after node at; returns the new tail
+ */
+static int step(int at, const byteSet &set, char quant)
+{
+    int out = newNode();
+    switch (quant)
+    {
+    case '*':
+        nfa[at].eps.push_back(out);
+        nfa[out].on = set;
+        nfa[out].to = out;
+        break;
+    case '+':
+        nfa[at].on = set;
+        nfa[at].to = out;
+        nfa[out].on = set;
+        nfa[out].to = out;
+        break;
+    case '?':
+        nfa[at].eps.push_back(out);
+        /* fall through */
+    default:
+        nfa[at].on = set;
+        nfa[at].to = out;
+        break;
+    }
+    // a node carries one byte edge, so chain a fresh tail after loops
+    if (quant == '*' || quant == '+')
+    {
+        int tail = newNode();
+        nfa[out].eps.push_back(tail);
+        return tail;
+    }
+    return out;
+}
+
+/**
+ * @brief Compile one rule's pattern into the NFA, reachable from start
+ */
+static void compileRule(int start, const char *p, int rule)
+{
+    int at = newNode();
+    nfa[start].eps.push_back(at);
+    while (*p)
+    {
+        if (*p == ' ' || *p == '\t')
+            p++;
+        else if (*p == '"')
+        {
+            for (p++; *p != '"'; )
+            {
+                byteSet one;
+                one.set(patChar(p));
+                at = step(at, one, 0);
+            }
+            p++;
+            if (*p == '*' || *p == '+' || *p == '?')
+                fail("quantifiers apply to [sets] only");
+        }
+        else if (*p == '[')
+        {
+            byteSet set = parseSet(p);
+            char quant = 0;
+            if (*p == '*' || *p == '+' || *p == '?')
+                quant = *p++;
+            at = step(at, set, quant);
+        }
+        else
+            fail(std::string("unexpected '") + *p + "' in pattern");
+    }
+    nfa[at].accept = rule;
+}
+
+/**
+ * @brief Read the spec; returns the NFA start node
+ */
+static int readSpec(FILE *in)
+{
+    char line[1024];
+    int start = newNode();
+    while (fgets(line, sizeof line, in))
+    {
+        lineNo++;
+        line[strcspn(line, "\r\n")] = 0;
+        char *p = line + strspn(line, " \t");
+        if (*p == 0 || *p == '#')
+            continue;
+        size_t n = strcspn(p, " \t");
+        std::string name(p, n);
+        p += n;
+        p += strspn(p, " \t");
+        if (*p == 0)
+            fail("rule " + name + " has no pattern");
+        if (name == "%skip")
+        {
+            if (*p != '[')
+                fail("%skip takes a [set]");
+            const char *set = p;
+            skip |= parseSet(set);
+            continue;
+        }
+        rules.push_back(name);
+        compileRule(start, p, (int)rules.size() - 1);
+    }
+    if (rules.empty())
+        fail("no rules");
+    return start;
+}
+
+static void closure(std::set<int> &states)
+{
+    std::vector<int> work(states.begin(), states.end());
+    while (!work.empty())
+    {
+        int s = work.back();
+        work.pop_back();
+        for (size_t i = 0; i < nfa[s].eps.size(); i++)
+            if (states.insert(nfa[s].eps[i]).second)
+                work.push_back(nfa[s].eps[i]);
+    }
+}
+
+/* DFA: state 0 is the dead state, state 1 the start state */
+static std::vector<std::vector<int> > dfaNext;
+static std::vector<int> dfaAccept;
+
+/**
+ * @brief Subset construction
+ */
+static void buildDfa(int start)
+{
+    std::map<std::set<int>, int> ids;
+    std::vector<std::set<int> > sets;
+    std::set<int> first;
+
+    sets.push_back(std::set<int>());
+    ids[sets[0]] = 0;
+    first.insert(start);
+    closure(first);
+    ids[first] = 1;
+    sets.push_back(first);
+    for (size_t d = 0; d < sets.size(); d++)
+    {
+        int accept = -1;
+        for (std::set<int>::iterator it = sets[d].begin(); it != sets[d].end(); ++it)
+            if (nfa[*it].accept >= 0 && (accept < 0 || nfa[*it].accept < accept))
+                accept = nfa[*it].accept;
+        dfaAccept.push_back(accept);
+        dfaNext.push_back(std::vector<int>(256, 0));
+        for (int c = 0; c < 256; c++)
+        {
+            std::set<int> to;
+            for (std::set<int>::iterator it = sets[d].begin(); it != sets[d].end(); ++it)
+                if (nfa[*it].to >= 0 && nfa[*it].on.test(c))
+                    to.insert(nfa[*it].to);
+            closure(to);
+            std::map<std::set<int>, int>::iterator found = ids.find(to);
+            if (found == ids.end())
+            {
+                found = ids.insert(std::make_pair(to, (int)sets.size())).first;
+                sets.push_back(to);
+            }
+            dfaNext[d][c] = found->second;
+        }
+    }
+}
+
+/**
+ * @brief Moore partition refinement; keeps dead = 0 and start = 1
+ */
+static void minimize()
+{
+    size_t n = dfaNext.size();
+    std::vector<int> block(n);
+    size_t count = 0;
+
+    // initial blocks: one per accepted rule (dead state alone with -1)
+    for (bool changed = true; changed;)
+    {
+        std::map<std::vector<int>, int> sig;
+        std::vector<int> next(n);
+        for (size_t s = 0; s < n; s++)
+        {
+            std::vector<int> key(1, dfaAccept[s]);
+            if (count > 0)
+            {
+                key.push_back(block[s]);
+                for (int c = 0; c < 256; c++)
+                    key.push_back(block[dfaNext[s][c]]);
+            }
+            std::map<std::vector<int>, int>::iterator it = sig.find(key);
+            if (it == sig.end())
+                it = sig.insert(std::make_pair(key, (int)sig.size())).first;
+            next[s] = it->second;
+        }
+        changed = sig.size() != count;
+        count = sig.size();
+        block = next;
+    }
+
+    // renumber blocks so the dead block is 0 and the start block 1
+    std::vector<int> order(count, -1);
+    int used = 0;
+    order[block[0]] = used++;
+    if (order[block[1]] < 0)
+        order[block[1]] = used++;
+    for (size_t s = 0; s < n; s++)
+        if (order[block[s]] < 0)
+            order[block[s]] = used++;
+
+    std::vector<std::vector<int> > next(count, std::vector<int>(256, 0));
+    std::vector<int> accept(count, -1);
+    for (size_t s = 0; s < n; s++)
+    {
+        int b = order[block[s]];
+        accept[b] = dfaAccept[s];
+        for (int c = 0; c < 256; c++)
+            next[b][c] = order[block[dfaNext[s][c]]];
+    }
+    dfaNext.swap(next);
+    dfaAccept.swap(accept);
+}
+
+static void emitBytes(FILE *out, const char *name, const std::vector<int> &v)
+{
+    fprintf(out, "static const unsigned char %s[256] = {", name);
+    for (int c = 0; c < 256; c++)
+        fprintf(out, "%s%d%s", c % 16 ? " " : "\n    ", v[c], c < 255 ? "," : "");
+    fprintf(out, "\n};\n\n");
+}
+
+static std::string acceptName(int state)
+{
+    return dfaAccept[state] < 0 ? "-1" : rules[dfaAccept[state]];
+}
+
+/**
+ * @brief Write lexer_dfa.h
+ */
+static void emit(FILE *out)
+{
+    size_t states = dfaNext.size();
+
+    // bytes with identical columns share a class
+    std::map<std::vector<int>, int> columns;
+    std::vector<int> byteClass(256);
+    for (int c = 0; c < 256; c++)
+    {
+        std::vector<int> col(states);
+        for (size_t s = 0; s < states; s++)
+            col[s] = dfaNext[s][c];
+        std::map<std::vector<int>, int>::iterator it = columns.find(col);
+        if (it == columns.end())
+            it = columns.insert(std::make_pair(col, (int)columns.size())).first;
+        byteClass[c] = it->second;
+    }
+    size_t classes = columns.size();
+    std::vector<int> sample(classes);
+    for (int c = 255; c >= 0; c--)
+        sample[byteClass[c]] = c;
+
+    fprintf(out, "/* lexer_dfa.h - generated by lexgen from %s; do not edit.\n"
+                 "   %zu rules, %zu states (incl. dead), %zu byte classes */\n"
+                 "#ifndef LEXER_DFA_H\n#define LEXER_DFA_H\n\n",
+            specPath, rules.size(), states, classes);
+
+    std::vector<int> skipBytes(256);
+    for (int c = 0; c < 256; c++)
+        skipBytes[c] = skip.test(c);
+    emitBytes(out, "dfaSkip", skipBytes);
+    emitBytes(out, "dfaClass", byteClass);
+
+    fprintf(out, "#if !defined(__GNUC__)\nstatic const unsigned char dfaNext[%zu][%zu] = {\n",
+            states, classes);
+    for (size_t s = 0; s < states; s++)
+    {
+        fprintf(out, "    {");
+        for (size_t k = 0; k < classes; k++)
+            fprintf(out, "%d%s", dfaNext[s][sample[k]], k + 1 < classes ? ", " : "");
+        fprintf(out, "},\n");
+    }
+    fprintf(out, "};\n\nstatic const int dfaAccept[%zu] = {", states);
+    for (size_t s = 0; s < states; s++)
+        fprintf(out, "%s%s", acceptName(s).c_str(), s + 1 < states ? ", " : "");
+    fprintf(out, "};\n#endif\n\n");
+
+    fprintf(out,
+            "/* dfaScan - longest match at p; returns its length (0 when no rule\n"
+            " * matches) and stores the token code in *code */\n"
+            "static inline size_t dfaScan(const unsigned char *p, const unsigned char *end, int *code)\n"
+            "{\n"
+            "    const unsigned char *start = p, *mark = p;\n"
+            "#if defined(__GNUC__)\n");
+    for (size_t s = 1; s < states; s++)
+    {
+        fprintf(out, "    static void *const go%zu[%zu] = {", s, classes);
+        for (size_t k = 0; k < classes; k++)
+        {
+            int to = dfaNext[s][sample[k]];
+            if (to == 0)
+                fprintf(out, "&&done");
+            else
+                fprintf(out, "&&s%d", to);
+            fprintf(out, "%s", k + 1 < classes ? ", " : "};\n");
+        }
+    }
+    std::vector<bool> target(states);
+    for (size_t s = 1; s < states; s++)
+        for (int c = 0; c < 256; c++)
+            target[dfaNext[s][c]] = true;
+    // the start state is entered by falling through
+    for (size_t s = 1; s < states; s++)
+    {
+        if (target[s])
+            fprintf(out, "s%zu:\n", s);
+        if (dfaAccept[s] >= 0)
+            fprintf(out, "    *code = %s;\n    mark = p;\n", acceptName(s).c_str());
+        fprintf(out, "    if (p == end)\n        goto done;\n"
+                     "    goto *go%zu[dfaClass[*p++]];\n",
+                s);
+    }
+    fprintf(out, "done:\n"
+                 "#else\n"
+                 "    for (int s = 1; s != 0; s = p == end ? 0 : dfaNext[s][dfaClass[*p++]])\n"
+                 "        if (dfaAccept[s] >= 0)\n"
+                 "        {\n"
+                 "            *code = dfaAccept[s];\n"
+                 "            mark = p;\n"
+                 "        }\n"
+                 "#endif\n"
+                 "    return (size_t)(mark - start);\n"
+                 "}\n\n");
+
+    fprintf(out, "/* dfaTokenName - name of a token code of the spec */\n"
+                 "static inline const char *dfaTokenName(int code)\n{\n    switch (code)\n    {\n");
+    std::set<std::string> named;
+    for (size_t r = 0; r < rules.size(); r++)
+        if (named.insert(rules[r]).second)
+            fprintf(out, "    case %s:\n        return \"%s\";\n", rules[r].c_str(), rules[r].c_str());
+    fprintf(out, "    default:\n        return \"UNKNOWN\";\n    }\n}\n\n#endif\n");
+}
+
+int main(int argc, char **argv)
+{
+    if (argc != 3)
+    {
+        fprintf(stderr, "Usage: ./lexgen <tokens.spec> <lexer_dfa.h>\n");
+        return 1;
+    }
+    specPath = argv[1];
+    FILE *in = fopen(argv[1], "r");
+    if (in == nullptr)
+    {
+        fprintf(stderr, "lexgen: cannot open %s\n", argv[1]);
+        return 1;
+    }
+    int start = readSpec(in);
+    fclose(in);
+
+    buildDfa(start);
+    minimize();
+    if (dfaNext.size() > 255)
+    {
+        fprintf(stderr, "lexgen: %zu states do not fit the byte-wide table\n", dfaNext.size());
+        return 1;
+    }
+
+    FILE *out = fopen(argv[2], "w");
+    if (out == nullptr)
+    {
+        fprintf(stderr, "lexgen: cannot write %s\n", argv[2]);
+        return 1;
+    }
+    emit(out);
+    if (fclose(out) != 0)
+    {
+        remove(argv[2]);
+        fprintf(stderr, "lexgen: cannot write %s\n", argv[2]);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,86 @@
+/*
+=============================================================================
+Title : lines.cpp
+Description : Byte offset to line:column mapping for diagnostics.
+Author : silrodri (R#11679913)
+Date : 10/19/2026
+Version : 2.0
+Usage : Built into libdcooke; see dc_locate() in dcooke.h
+Notes : The lexer only tracks byte offsets. The first lookup scans the
+        source for '\n' 16 bytes at a time with SSE2 and records the offset
+        of every newline; later lookups binary search that index. Input fed
+        after the scan is indexed on the next lookup, so a clean run never
+        pays for it.
+C++ Version : cpp (GCC) 4.8.5 20150623 (Red Hat 4.8.5-16)
+=============================================================================
+*/
+#include <algorithm>
+#include <cstdio>
+
+// build with -DDC_NO_SSE2 to force the byte-at-a-time scan
+#if defined(__SSE2__) && !defined(DC_NO_SSE2)
+#include <emmintrin.h>
+#define DC_HAVE_SSE2 1
+#endif
+
+#include "context.h"
+
+/**
+ * @brief Append the offsets of the newlines in src[from, to) to the index
+ */
+static void indexNewlines(dc_context *ctx, size_t from, size_t to)
+{
+    const char *src = ctx->src.data();
+    size_t i = from;
+#ifdef DC_HAVE_SSE2
+    const __m128i nl = _mm_set1_epi8('\n');
+    for (; i + 16 <= to; i += 16)
+    {
+        __m128i block = _mm_loadu_si128((const __m128i *)(src + i));
+        unsigned bits = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(block, nl));
+        while (bits)
+        {
+            ctx->newlines.push_back(i + __builtin_ctz(bits));
+            bits &= bits - 1;
+        }
+    }
+#endif
+    for (; i < to; i++)
+        if (src[i] == '\n')
+            ctx->newlines.push_back(i);
+}
+
+int dc_locate(dc_context *ctx, size_t offset, size_t *line, size_t *column)
+{
+    if (offset > ctx->src.size())
+        return -1;
+    if (ctx->indexed < ctx->src.size())
+    {
+        indexNewlines(ctx, ctx->indexed, ctx->src.size());
+        ctx->indexed = ctx->src.size();
+    }
+
+    // newlines before offset = its 0-based line
+    size_t before = std::lower_bound(ctx->newlines.begin(), ctx->newlines.end(), offset) -
+                    ctx->newlines.begin();
+    size_t lineStart = before == 0 ? 0 : ctx->newlines[before - 1] + 1;
+    if (line)
+        *line = before + 1;
+    if (column)
+        *column = offset - lineStart + 1;
+    return 0;
+}
+
+/**
+ * @brief Append " at line L, column C" for a source offset (nothing past
+ *  the input)
+ */
+void where(dc_context *ctx, size_t offset, std::string *out)
+{
+    char text[64];
+    size_t line, column;
+    if (dc_locate(ctx, offset, &line, &column) != 0)
+        return;
+    snprintf(text, sizeof text, " at line %zu, column %zu", line, column);
+    *out += text;
+}
@@ -0,0 +1,424 @@
+/*
+=============================================================================
+Title : parser.cpp
+Description : This is part of a syntax analyzer program.
+Author : silrodri (R#11679913)
+Date : 10/19/2026
+Version : 2.0
+Usage : Built into libdcooke; driven by dc_parse()
+Notes : This program is dependent on the lexical analyzer (lexer.cpp).
+C++ Version : cpp (GCC) 4.8.5 20150623 (Red Hat 4.8.5-16)
+=============================================================================
+*/
+#include "context.h"
+#include "parser.h"
+
+static void error(dc_context *ctx, const char *details);
+
+/**
+ * @brief Append a statement node and return its index
+ */
+static int newStmt(dc_context *ctx, int kind, size_t offset)
+{
+    dc_stmt st;
+    st.kind = kind;
+    st.symbol = st.expr = st.body = st.cond = st.next = -1;
+    st.offset = offset;
+    ctx->ast.stmts.push_back(st);
+    return (int)ctx->ast.stmts.size() - 1;
+}
+
+/**
+ * @brief Append an expression node and return its index
+ */
+static int newExpr(dc_context *ctx, int op, int left, int right, size_t offset)
+{
+    dc_expr ex;
+    ex.op = op;
+    ex.left = left;
+    ex.right = right;
+    ex.symbol = -1;
+    ex.value = 0;
+    ex.offset = offset;
+    ctx->ast.exprs.push_back(ex);
+    return (int)ctx->ast.exprs.size() - 1;
+}
+
+/**
+ * @brief Count one more level of do-body or parenthesis nesting
+ * @return bool : false once the nesting limit is exceeded
+ */
+static bool enter(dc_context *ctx)
+{
+    if (ctx->limits.maxDepth && ++ctx->depth > ctx->limits.maxDepth)
+    {
+        limitExceeded(ctx, "nesting depth", ctx->limits.maxDepth);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Parse a single statement (no trailing ';')
+ * @return int : index of its statement node, or -1
+ */
+static int oneStatement(dc_context *ctx)
+{
+    int s = -1;
+    int kind, sym, body, cond;
+    size_t at = ctx->tokenStart;
+
+    // Check which statement was entered:
+    switch (ctx->nextToken)
+    {
+    // V = E
+    case IDENT:
+        sym = ctx->symbol;
+        lex(ctx); // update lexeme
+        if (ctx->nextToken == ASSIGN_OP)
+        {
+            lex(ctx);
+            s = newStmt(ctx, ASSIGN_OP, at);
+            ctx->ast.stmts[s].symbol = sym;
+            ctx->ast.stmts[s].expr = expr(ctx);
+        }
+        break;
+    // read(IDENT) or write(IDENT) can be handled the same
+    case KEY_READ:
+    case KEY_WRITE:
+        kind = ctx->nextToken;
+        // par branches run on snapshots, so input order would be undefined
+        if (kind == KEY_READ && ctx->parDepth > 0)
+            error(ctx, "read is not allowed inside par");
+        lex(ctx); // update lexeme
+        if (ctx->nextToken == LEFT_PAREN)
+        {
+            lex(ctx);
+            // Must be an ident (V)
+            if (ctx->nextToken == IDENT)
+            {
+                s = newStmt(ctx, kind, at);
+                ctx->ast.stmts[s].symbol = ctx->symbol;
+                lex(ctx);
+                // Missing close paren ?
+                if (ctx->nextToken == RIGHT_PAREN)
+                    lex(ctx);
+                else
+                    error(ctx, "Expected ')'");
+            }
+        }
+        // Missing left paren
+        else if (ctx->shadowCode == NoError)
+            error(ctx, "Expected '('");
+        break;
+    // do {statements} while(conditional)
+    case KEY_DO:
+        lex(ctx);
+        if (ctx->nextToken == LEFT_CBRACE)
+        {
+            lex(ctx); // update lexeme
+            body = cond = -1;
+            if (enter(ctx))
+                body = statement(ctx); // resolve statements
+            ctx->depth--;
+            if (ctx->nextToken == RIGHT_CBRACE)
+                lex(ctx); // move on
+            else if (ctx->shadowCode == NoError)
+                error(ctx, "Expected '}'");
+            // following c brace, need to see a while
+            if (ctx->nextToken == KEY_WHILE)
+            {
+                lex(ctx); // move on to next lexeme
+                if (ctx->nextToken == LEFT_PAREN)
+                {
+                    lex(ctx);                 // move into while
+                    cond = conditional(ctx); // resolve conditional
+                    if (ctx->nextToken == RIGHT_PAREN)
+                        lex(ctx);
+                    // missing close paren
+                    else if (ctx->shadowCode == NoError)
+                        error(ctx, "Expected ')'");
+                }
+                // missing left paren
+                else if (ctx->shadowCode == NoError)
+                    error(ctx, "Expected '('");
+            }
+            // missing while(conditional)
+            else if (ctx->shadowCode == NoError)
+                error(ctx, "Expected 'while(conditional)'");
+            s = newStmt(ctx, KEY_DO, at);
+            ctx->ast.stmts[s].body = body;
+            ctx->ast.stmts[s].cond = cond;
+        }
+        // Missing left cbrace
+        else if (ctx->shadowCode == NoError)
+            error(ctx, "Expected '{'");
+        break;
+    // par {statements}: the statements run in parallel
+    case KEY_PAR:
+        lex(ctx);
+        if (ctx->nextToken == LEFT_CBRACE)
+        {
+            lex(ctx); // update lexeme
+            body = -1;
+            ctx->parDepth++;
+            if (enter(ctx))
+                body = statement(ctx); // resolve statements
+            ctx->depth--;
+            ctx->parDepth--;
+            if (ctx->nextToken == RIGHT_CBRACE)
+                lex(ctx); // move on
+            else if (ctx->shadowCode == NoError)
+                error(ctx, "Expected '}'");
+            s = newStmt(ctx, KEY_PAR, at);
+            ctx->ast.stmts[s].body = body;
+        }
+        // Missing left cbrace
+        else if (ctx->shadowCode == NoError)
+            error(ctx, "Expected '{'");
+        break;
+    // error last line statement entrance
+    case EOF:
+        error(ctx, "Last line does not support semicolon ';'");
+        break;
+    // unsupported entrance - expected last statement no semicolon
+    default:
+        error(ctx, "Expected a semicolon ';'");
+        break;
+    }
+    return s;
+}
+
+/**
+ * @brief Handle statement call: s {; s}
+ * @return int : index of the first statement node of the list parsed, or -1
+ */
+int statement(dc_context *ctx)
+{
+    int first = -1, last = -1;
+    for (;;)
+    {
+        int s = oneStatement(ctx);
+        if (s >= 0)
+        {
+            if (last < 0)
+                first = s;
+            else
+                ctx->ast.stmts[last].next = s;
+            last = s;
+        }
+        // statement handled, check for semicolon
+        if (ctx->nextToken != SEMICOLON)
+            break; // Last statement doesn't need to reset shadowCode
+        lex(ctx);                  // move on to next statement
+        ctx->shadowCode = NoError; // Reset this so that next statement can track errors again
+    }
+    return first;
+}
+
+/**
+ * @brief : Binding strength of each binary operator token, 0 for every
+ *  other token. Comparators only bind at the top of a conditional
+ */
+static const unsigned char precedence[KEY_PAR + 1] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, // character classes
+    0, 1, 1, 1, 1, 1, 1, 0,       // ASSIGN_OP, the comparators, SEMICOLON
+    2, 2, 3, 3,                   // ADD_OP, SUB_OP, MULT_OP, DIV_OP
+};
+static_assert(LESSER_OP == 11 && GEQUAL_OP == 16 && ADD_OP == 18 && DIV_OP == 21,
+              "precedence[] follows the token codes of front.h");
+
+static int bindingOf(int token)
+{
+    return token >= 0 && token <= KEY_PAR ? precedence[token] : 0;
+}
+
+/**
+ * @brief Build the pending operators of this expression that bind at
+ *  least as tightly as prec, stopping at an open parenthesis
+ */
+static void reduce(dc_context *ctx, size_t base, int prec)
+{
+    while (ctx->operators.size() > base && ctx->operators.back().code != LEFT_PAREN &&
+           precedence[ctx->operators.back().code] >= prec)
+    {
+        int op = ctx->operators.back().code;
+        ctx->operators.pop_back();
+        int right = ctx->operands.back().code;
+        ctx->operands.pop_back();
+        dc_exprslot &left = ctx->operands.back();
+        // a node sits at the first token of its left operand
+        left.code = newExpr(ctx, op, left.code, right, left.at);
+    }
+}
+
+/**
+ * @brief The ')' that ends a parenthesized expression
+ */
+static void closeParen(dc_context *ctx)
+{
+    if (ctx->nextToken == RIGHT_PAREN)
+        lex(ctx);
+    // missing closing paren
+    else if (ctx->shadowCode == NoError)
+        error(ctx, "Expected ')'");
+}
+
+/**
+ * @brief An operand that is not parenthesized: IDENT(INC/DEC) | INT_LIT | IDENT
+ */
+static int leaf(dc_context *ctx)
+{
+    int e = -1;
+    size_t at = ctx->tokenStart;
+    switch (ctx->nextToken)
+    {
+    // V++, V--, or just V?
+    case IDENT:
+        e = newExpr(ctx, IDENT, -1, -1, at);
+        ctx->ast.exprs[e].symbol = ctx->symbol;
+        lex(ctx);
+        if (ctx->nextToken == INC_OP || ctx->nextToken == DEC_OP)
+        {
+            ctx->ast.exprs[e].op = ctx->nextToken;
+            lex(ctx);
+        }
+        break;
+    // Number
+    case INT_LIT:
+        e = newExpr(ctx, INT_LIT, -1, -1, at);
+        ctx->ast.exprs[e].value = ctx->intValue;
+        lex(ctx); // update lexeme
+        break;
+    // unsupported operand
+    default:
+        error(ctx, "Unsupported call to factor");
+        break;
+    }
+    return e;
+}
+
+/* Parses strings in the language generated by the rules:
+ * <conditional> -> <expr> (< | > | == | != | <= | >=) <expr>
+ * <expr> -> <term> {(+ | -) <term>}
+ * <term> -> <factor> {(* | /) <factor>}
+ * <factor> -> ( <expr> ) | IDENT(INC/DEC) | INT_LIT | IDENT
+ * with operator and operand stacks instead of one C++ call per rule, so
+ * nesting costs no native stack. The checks (and diagnostics) happen
+ * where the recursive rules made them: "Invalid Operation" where a term
+ * ends, ')' where a factor ends and the comparator after the first expr.
+ * Returns the index of the root node, or -1
+ */
+static int parseExpr(dc_context *ctx, bool condition)
+{
+    const size_t ops = ctx->operators.size(), vals = ctx->operands.size();
+    size_t parens = 0; // open in this expression
+    bool compared = false;
+    for (;;)
+    {
+        // an operand; '(' opens a group and another operand follows
+        dc_exprslot operand;
+        operand.at = ctx->tokenStart;
+        operand.code = -1;
+        if (ctx->nextToken == LEFT_PAREN)
+        {
+            lex(ctx);
+            if (enter(ctx))
+            {
+                ctx->operators.push_back(operand);
+                ctx->operators.back().code = LEFT_PAREN;
+                parens++;
+                continue;
+            }
+            ctx->depth--;
+            closeParen(ctx);
+        }
+        else
+            operand.code = leaf(ctx);
+        ctx->operands.push_back(operand);
+
+        // then an operator, or the end of a group or of the expression
+        for (;;)
+        {
+            int op = ctx->nextToken;
+            if (op == UNKNOWN && ctx->shadowCode == NoError)
+                error(ctx, "Invalid Operation");
+            int prec = bindingOf(op);
+            if (prec == 1 && (!condition || parens > 0 || compared))
+                prec = 0;
+            if (prec > 0)
+            {
+                reduce(ctx, ops, prec);
+                operand.code = op;
+                ctx->operators.push_back(operand);
+                compared = compared || prec == 1;
+                lex(ctx);
+                break;
+            }
+            reduce(ctx, ops, 1);
+            if (parens == 0)
+            {
+                int root = ctx->operands.back().code;
+                ctx->operands.resize(vals);
+                ctx->operators.resize(ops);
+                if (!condition || compared)
+                    return root;
+                // invalid comparator operator
+                if (ctx->shadowCode == NoError)
+                    error(ctx, "Invalid Comparitor Operator");
+                return -1;
+            }
+            // the group becomes an operand starting at its '('
+            ctx->operands.back().at = ctx->operators.back().at;
+            ctx->operators.pop_back();
+            parens--;
+            ctx->depth--;
+            closeParen(ctx);
+        }
+    }
+}
+
+/**
+ * @brief Conditional: Return the checks for a conditional statment
+ *  expr (op) expr
+ * @return int : index of the comparison node, or -1
+ */
+int conditional(dc_context *ctx)
+{
+    return parseExpr(ctx, true);
+}
+
+/**
+ * @brief Expression: <term> {(+ | -) <term>}
+ * @return int : index of its root node, or -1
+ */
+int expr(dc_context *ctx)
+{
+    return parseExpr(ctx, false);
+}
+
+/**
+ * @brief Error handler routine
+ * @param details: String describing the problem for call
+ */
+static void error(dc_context *ctx, const char *details)
+{
+    // after a limit stops the run, the unwinding parser is not reporting news
+    if (ctx->exit_code == LimitExceeded)
+        return;
+    ctx->exit_code = ctx->shadowCode = SyntaxError;
+    // one buffer for the whole message, kept across runs
+    std::string &message = ctx->message;
+    message.reserve(160);
+    message = "error detected: ";
+    message += details;
+    // a pipelined parse places it after the lexer thread is done
+    if (ctx->ring == nullptr)
+        where(ctx, ctx->tokenStart, &message);
+    message += "\n";
+    message += ctx->lexeme;
+    message += " was the next lexeme ";
+    message += ctx->strNextToken;
+    message += " was the next token";
+    report(ctx, DC_DIAG_SYNTAX, message, ctx->tokenStart);
+}
\ No newline at end of file
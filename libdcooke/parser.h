@@ -0,0 +1,23 @@
+/*
+=============================================================================
+Title : parser.h
+Description : This is a header file for the syntax analyzer program.
+Author : silrodri (R#11679913)
+Date : 10/19/2026
+Version : 2.0
+Usage : Internal to libdcooke; imported into parser.cpp and dcooke.cpp
+Notes : This program is dependent on the lexical analyzer (lexer.cpp).
+C++ Version : cpp (GCC) 4.8.5 20150623 (Red Hat 4.8.5-16)
+=============================================================================
+*/
+#ifndef PARSER_H
+#define PARSER_H
+
+#include "context.h"
+
+/* Each returns the index of the AST node it built (-1 on a syntax error) */
+int expr(dc_context *ctx);
+int statement(dc_context *ctx);
+int conditional(dc_context *ctx);
+
+#endif
@@ -0,0 +1,228 @@
+/*
+=============================================================================
+Title : pipeline.cpp
+Description : Pipelined parse: lexer and parser on separate threads
+              (dc_parse_pipelined).
+Author : silrodri (R#11679913)
+Date : 10/19/2026
+Version : 2.0
+Usage : Built into libdcooke; see dc_parse_pipelined() in dcooke.h
+Notes : A lexer thread runs lex() on a scratch context and copies every
+        token into a bounded single-producer/single-consumer ring; the
+        parser's lex() calls take them back out. The two indices sit on
+        their own cache lines, and each side stores its index only once
+        per BATCH tokens (or before it waits), so the threads touch each
+        other's line a few times per batch rather than per token. The
+        lexer may run ahead of a syntax error, so afterwards the tokens,
+        symbols and diagnostics are cut back to what dc_parse() records.
+C++ Version : cpp (GCC) 4.8.5 20150623 (Red Hat 4.8.5-16)
+=============================================================================
+*/
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+#include "context.h"
+
+#define RING_SIZE 4096 // tokens in flight; a power of two
+#define BATCH 64       // tokens per index store
+#define CACHE_LINE 64
+
+/**
+ * @brief : What the parser reads of one token
+ */
+struct dc_tokslot
+{
+    int code;
+    int symbol;
+    long long value;
+    size_t offset;
+    size_t diags;   // lexer diagnostics raised up to this token
+    size_t symbols; // symbols interned up to this token
+    int len;           // lexLen
+    size_t size;       // bytes of lexeme with its NUL ("EOF" has lexLen 0)
+    char lexeme[100];
+};
+
+struct dc_tokring
+{
+    char pad0[CACHE_LINE];
+
+    /* lexer side */
+    std::atomic<size_t> tail; // tokens published
+    size_t written;           // tokens stored, published or not
+    size_t headSeen;          // last head loaded
+    char pad1[CACHE_LINE];
+
+    /* parser side */
+    std::atomic<size_t> head; // tokens released
+    size_t taken;             // tokens copied out, released or not
+    size_t tailSeen;          // last tail loaded
+    char pad2[CACHE_LINE];
+
+    std::atomic<bool> stop; // the parser is done; the lexer should quit
+    bool ended;             // the parser has taken EOF
+    size_t tokens;          // non-EOF tokens taken
+    size_t diags, symbols;  // counts carried by the last token taken
+    dc_tokslot slots[RING_SIZE];
+};
+
+/**
+ * @brief Lexer thread: scan lx into the ring until EOF or a stop
+ */
+static void lexInto(dc_context *lx, dc_tokring *ring)
+{
+    for (;;)
+    {
+        int code = lex(lx);
+        // full: publish what is stored, then wait for the parser
+        while (ring->written - ring->headSeen == RING_SIZE)
+        {
+            ring->tail.store(ring->written, std::memory_order_release);
+            ring->headSeen = ring->head.load(std::memory_order_acquire);
+            if (ring->written - ring->headSeen < RING_SIZE)
+                break;
+            if (ring->stop.load(std::memory_order_relaxed))
+                return;
+            std::this_thread::yield();
+        }
+
+        dc_tokslot &t = ring->slots[ring->written & (RING_SIZE - 1)];
+        t.code = code;
+        t.symbol = lx->symbol;
+        t.value = lx->intValue;
+        t.offset = lx->tokenStart;
+        t.diags = lx->diags.size();
+        t.symbols = lx->symbols.syms.size();
+        t.len = lx->lexLen;
+        t.size = strlen(lx->lexeme) + 1;
+        memcpy(t.lexeme, lx->lexeme, t.size);
+        ring->written++;
+
+        if (code == EOF)
+        {
+            ring->tail.store(ring->written, std::memory_order_release);
+            return;
+        }
+        if (ring->written % BATCH == 0)
+        {
+            ring->tail.store(ring->written, std::memory_order_release);
+            if (ring->stop.load(std::memory_order_relaxed))
+                return;
+        }
+    }
+}
+
+/**
+ * @brief lex() of a pipelined parse: the next token from the ring
+ */
+int takeToken(dc_context *ctx)
+{
+    dc_tokring *ring = ctx->ring;
+    if (ring->ended)
+        return EOF;
+    // empty: release what was taken, then wait for the lexer
+    while (ring->taken == ring->tailSeen)
+    {
+        ring->head.store(ring->taken, std::memory_order_release);
+        ring->tailSeen = ring->tail.load(std::memory_order_acquire);
+        if (ring->taken == ring->tailSeen)
+            std::this_thread::yield();
+    }
+
+    const dc_tokslot &t = ring->slots[ring->taken & (RING_SIZE - 1)];
+    ctx->nextToken = t.code;
+    ctx->symbol = t.symbol;
+    ctx->intValue = t.value;
+    ctx->tokenStart = t.offset;
+    ctx->lexLen = t.len;
+    memcpy(ctx->lexeme, t.lexeme, t.size);
+    ctx->lexDiags = ring->diags = t.diags;
+    ring->symbols = t.symbols;
+    if (t.code == EOF)
+        ring->ended = true;
+    else
+    {
+        ctx->strNextToken = dc_token_name(t.code);
+        ring->tokens++;
+    }
+
+    if (++ring->taken % BATCH == 0)
+        ring->head.store(ring->taken, std::memory_order_release);
+    return ctx->nextToken;
+}
+
+/**
+ * @brief Interleave the lexer's diagnostics with the parser's as a
+ *  sequential run raises them, and give syntax errors their position
+ */
+static void mergeDiags(dc_context *ctx, dc_context *lx, size_t lexed)
+{
+    std::vector<dc_diag_rec> merged;
+    size_t next = 0;
+
+    for (size_t i = 0; i < ctx->diags.size(); i++)
+    {
+        dc_diag_rec &d = ctx->diags[i];
+        while (next < d.lexBefore)
+            merged.push_back(lx->diags[next++]);
+        if (d.kind == DC_DIAG_SYNTAX && d.offset != DC_NO_OFFSET)
+        {
+            std::string at;
+            where(ctx, d.offset, &at);
+            d.message.insert(d.message.find('\n'), at);
+        }
+        merged.push_back(d);
+    }
+    while (next < lexed)
+        merged.push_back(lx->diags[next++]);
+    ctx->diags.swap(merged);
+}
+
+exitCode dc_parse_pipelined(dc_context *ctx)
+{
+    // caps are checked in step with the parser; keep those runs sequential
+    const dc_limits none = dc_limits();
+    if (memcmp(&ctx->limits, &none, sizeof none) != 0)
+        return dc_parse(ctx);
+
+    beginRun(ctx);
+    dc_context *lx = new dc_context();
+    dc_tokring *ring = new dc_tokring();
+    lx->src.swap(ctx->src);
+    lx->pull = ctx->pull;
+    lx->pullUser = ctx->pullUser;
+    lx->tokens.swap(ctx->tokens);
+    lx->lexemes.swap(ctx->lexemes);
+    std::swap(lx->symbols, ctx->symbols);
+    lexBegin(lx);
+
+    ring->tail = ring->head = 0;
+    ring->stop = false;
+    ctx->ring = ring;
+    std::thread lexer(lexInto, lx, ring);
+    parseProgram(ctx);
+    ring->stop = true;
+    lexer.join();
+    ctx->ring = nullptr;
+
+    // drop whatever the lexer scanned past the last token the parser took
+    if (ring->tokens < lx->tokens.size())
+    {
+        lx->lexemes.resize(lx->tokens[ring->tokens].lexemeAt);
+        lx->tokens.resize(ring->tokens);
+    }
+    symTruncate(&lx->symbols, ring->symbols);
+    ctx->src.swap(lx->src);
+    ctx->pull = lx->pull;
+    ctx->pos = lx->pos;
+    ctx->tokens.swap(lx->tokens);
+    ctx->lexemes.swap(lx->lexemes);
+    std::swap(ctx->symbols, lx->symbols);
+    mergeDiags(ctx, lx, ring->diags);
+
+    delete ring;
+    delete lx;
+    return ctx->exit_code;
+}
@@ -0,0 +1,155 @@
+/*
+=============================================================================
+Title : pool.cpp
+Description : Work-stealing thread pool for fork/join tasks.
+Author : silrodri (R#11679913)
+Date : 10/19/2026
+Version : 2.0
+Usage : Built into libdcooke; see pool.h
+Notes : The deques are short and touched once per task, so each has its
+        own mutex instead of a lock-free Chase-Lev array. Idle workers
+        sleep on a condition variable until a fork queues work.
+C++ Version : cpp (GCC) 4.8.5 20150623 (Red Hat 4.8.5-16)
+=============================================================================
+*/
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "pool.h"
+
+struct dc_worker
+{
+    std::mutex lock;
+    std::deque<dc_task> tasks;
+};
+
+struct dc_pool
+{
+    std::vector<dc_worker *> workers;
+    std::vector<std::thread> threads;
+    std::mutex sleepLock;
+    std::condition_variable wake;
+    std::atomic<int> queued; // tasks sitting in any deque
+    bool stop;
+};
+
+/* index of the calling thread in the pool that is running it */
+static thread_local unsigned self;
+
+/**
+ * @brief Take a task: own deque from the back, else steal from a front
+ */
+static bool take(dc_pool *pool, unsigned me, dc_task *task)
+{
+    size_t n = pool->workers.size();
+    for (size_t i = 0; i < n; i++)
+    {
+        dc_worker *w = pool->workers[(me + i) % n];
+        std::lock_guard<std::mutex> hold(w->lock);
+        if (w->tasks.empty())
+            continue;
+        if (i == 0)
+        {
+            *task = w->tasks.back();
+            w->tasks.pop_back();
+        }
+        else
+        {
+            *task = w->tasks.front();
+            w->tasks.pop_front();
+        }
+        pool->queued--;
+        return true;
+    }
+    return false;
+}
+
+static void runTask(const dc_task &task)
+{
+    task.fn(task.arg);
+    task.pending->fetch_sub(1);
+}
+
+static void workerLoop(dc_pool *pool, unsigned me)
+{
+    dc_task task;
+    self = me;
+    for (;;)
+    {
+        if (take(pool, me, &task))
+        {
+            runTask(task);
+            continue;
+        }
+        std::unique_lock<std::mutex> hold(pool->sleepLock);
+        while (!pool->stop && pool->queued == 0)
+            pool->wake.wait(hold);
+        if (pool->stop)
+            return;
+    }
+}
+
+dc_pool *poolCreate(unsigned workers)
+{
+    dc_pool *pool = new dc_pool();
+    if (workers == 0)
+        workers = std::max(1u, std::thread::hardware_concurrency());
+    pool->queued = 0;
+    pool->stop = false;
+    for (unsigned w = 0; w < workers; w++)
+        pool->workers.push_back(new dc_worker());
+    self = 0;
+    for (unsigned w = 1; w < workers; w++)
+        pool->threads.push_back(std::thread(workerLoop, pool, w));
+    return pool;
+}
+
+void poolDestroy(dc_pool *pool)
+{
+    {
+        std::lock_guard<std::mutex> hold(pool->sleepLock);
+        pool->stop = true;
+    }
+    pool->wake.notify_all();
+    for (size_t t = 0; t < pool->threads.size(); t++)
+        pool->threads[t].join();
+    for (size_t w = 0; w < pool->workers.size(); w++)
+        delete pool->workers[w];
+    delete pool;
+}
+
+unsigned poolSize(const dc_pool *pool)
+{
+    return (unsigned)pool->workers.size();
+}
+
+void poolFork(dc_pool *pool, const dc_task &task)
+{
+    dc_worker *w = pool->workers[self];
+    {
+        std::lock_guard<std::mutex> hold(w->lock);
+        w->tasks.push_back(task);
+    }
+    {
+        // under sleepLock so a worker about to sleep cannot miss it
+        std::lock_guard<std::mutex> hold(pool->sleepLock);
+        pool->queued++;
+    }
+    pool->wake.notify_one();
+}
+
+void poolJoin(dc_pool *pool, std::atomic<int> *pending)
+{
+    dc_task task;
+    while (pending->load() > 0)
+    {
+        if (take(pool, self, &task))
+            runTask(task);
+        else
+            std::this_thread::yield();
+    }
+}
@@ -0,0 +1,45 @@
+/*
+=============================================================================
+Title : pool.h
+Description : Work-stealing thread pool for fork/join tasks.
+Author : silrodri (R#11679913)
+Date : 10/19/2026
+Version : 2.0
+Usage : Internal to libdcooke; used by dc_run() for par branches
+Notes : Every worker owns a deque: it pushes and pops its own tasks at the
+        back (LIFO, cache warm) and steals from the front of the others
+        (FIFO, oldest and usually largest work). The thread that creates
+        the pool is worker 0, and poolJoin() runs tasks while it waits, so
+        nested forks never block a worker.
+C++ Version : cpp (GCC) 4.8.5 20150623 (Red Hat 4.8.5-16)
+=============================================================================
+*/
+#ifndef POOL_H
+#define POOL_H
+
+#include <atomic>
+
+/**
+ * @brief : One unit of work; *pending is decremented when it is done
+ */
+struct dc_task
+{
+    void (*fn)(void *arg);
+    void *arg;
+    std::atomic<int> *pending;
+};
+
+struct dc_pool;
+
+/* Start workers - 1 threads (0 = one per CPU); the caller is worker 0 */
+dc_pool *poolCreate(unsigned workers);
+void poolDestroy(dc_pool *pool);
+unsigned poolSize(const dc_pool *pool);
+
+/* Queue a task on the calling worker's deque */
+void poolFork(dc_pool *pool, const dc_task &task);
+
+/* Run or steal tasks until *pending drops to zero */
+void poolJoin(dc_pool *pool, std::atomic<int> *pending);
+
+#endif
@@ -0,0 +1,183 @@
+/*
+=============================================================================
+Title : profile.cpp
+Description : Statement profile of dc_run: flat report and folded stacks.
+Author : silrodri (R#11679913)
+Date : 10/19/2026
+Version : 2.0
+Usage : Built into libdcooke; see dc_set_profiling() in dcooke.h
+Notes : A profiled run is compiled with a DC_OP_COUNT instruction at the
+        start of every statement and before every do-while condition
+        (exec.cpp), so the counts are exact rather than sampled and an
+        unprofiled run pays nothing. Par branches count on their own copy
+        and add it in at the join, like their variables. This file maps
+        the counters back to the statements and loop nests of the AST.
+C++ Version : cpp (GCC) 4.8.5 20150623 (Red Hat 4.8.5-16)
+=============================================================================
+*/
+#include <algorithm>
+#include <cstdio>
+
+#include "context.h"
+
+/**
+ * @brief : One statement of the profile, in program order
+ */
+struct dc_profrow
+{
+    int stmt;
+    int parent;               // row of the enclosing do or par, -1 at top level
+    unsigned long long runs;  // times the statement started
+    unsigned long long self;  // its own work, see selfWork()
+    unsigned long long total; // self plus the work of what it contains
+};
+
+/**
+ * @brief A statement's own work: its runs, the condition tests of a
+ *  do-while, nothing for a par (its branches do the work)
+ */
+static unsigned long long selfWork(const dc_context *ctx, int s)
+{
+    const dc_stmt &st = ctx->ast.stmts[s];
+    if (st.kind == KEY_DO)
+        return ctx->hits[ctx->ast.stmts.size() + s];
+    return st.kind == KEY_PAR ? 0 : ctx->hits[s];
+}
+
+/**
+ * @brief Append the rows of statement list s and everything nested in it
+ */
+static void collect(const dc_context *ctx, int s, int parent, std::vector<dc_profrow> *rows)
+{
+    for (; s >= 0; s = ctx->ast.stmts[s].next)
+    {
+        dc_profrow row;
+        row.stmt = s;
+        row.parent = parent;
+        row.runs = ctx->hits[s];
+        row.self = row.total = selfWork(ctx, s);
+        rows->push_back(row);
+        collect(ctx, ctx->ast.stmts[s].body, (int)rows->size() - 1, rows);
+    }
+}
+
+/**
+ * @brief Every statement with its counts; inclusive totals filled in
+ */
+static void profileRows(const dc_context *ctx, std::vector<dc_profrow> *rows)
+{
+    collect(ctx, ctx->ast.first, -1, rows);
+    // a row comes after its parent, so a backward pass sums whole nests
+    for (size_t i = rows->size(); i-- > 0;)
+        if ((*rows)[i].parent >= 0)
+            (*rows)[(*rows)[i].parent].total += (*rows)[i].total;
+}
+
+/**
+ * @brief "line:col" of a statement
+ */
+static std::string position(dc_context *ctx, int s)
+{
+    size_t line = 0, column = 0;
+    dc_locate(ctx, ctx->ast.stmts[s].offset, &line, &column);
+    return std::to_string(line) + ":" + std::to_string(column);
+}
+
+/**
+ * @brief Short form of a statement: "do", "par", "x=", "read(x)", "write(x)"
+ */
+static std::string kindOf(const dc_context *ctx, int s)
+{
+    const dc_stmt &st = ctx->ast.stmts[s];
+    switch (st.kind)
+    {
+    case KEY_DO:
+        return "do";
+    case KEY_PAR:
+        return "par";
+    case KEY_READ:
+        return std::string("read(") + dc_symbol_name(ctx, st.symbol) + ")";
+    case KEY_WRITE:
+        return std::string("write(") + dc_symbol_name(ctx, st.symbol) + ")";
+    }
+    return std::string(dc_symbol_name(ctx, st.symbol)) + "=";
+}
+
+static bool byWork(const dc_profrow &a, const dc_profrow &b)
+{
+    return a.self > b.self;
+}
+
+void dc_set_profiling(dc_context *ctx, int on)
+{
+    ctx->profiling = on != 0;
+    if (on)
+        ctx->hits.clear();
+}
+
+int dc_profile_report(dc_context *ctx, FILE *out)
+{
+    if (ctx->hits.empty())
+        return -1;
+
+    std::vector<dc_profrow> rows;
+    unsigned long long work = 0, runs = 0;
+    profileRows(ctx, &rows);
+    for (size_t i = 0; i < rows.size(); i++)
+    {
+        work += rows[i].self;
+        runs += rows[i].runs;
+    }
+    // hottest first; ties stay in program order
+    std::stable_sort(rows.begin(), rows.end(), byWork);
+
+    fprintf(out, "Statement profile: %llu statement runs, %llu units of work\n", runs, work);
+    fprintf(out, "%14s %7s %14s %14s  %-10s %s\n", "self", "%", "total", "runs", "where",
+            "statement");
+    for (size_t i = 0; i < rows.size(); i++)
+    {
+        const dc_profrow &r = rows[i];
+        if (r.runs == 0)
+            continue;
+        fprintf(out, "%14llu %6.2f%% %14llu %14llu  %-10s %s", r.self,
+                work ? 100.0 * r.self / work : 0.0, r.total, r.runs,
+                position(ctx, r.stmt).c_str(), kindOf(ctx, r.stmt).c_str());
+        if (ctx->ast.stmts[r.stmt].kind == KEY_DO)
+            fprintf(out, " (%.1f tests per run)", (double)r.self / r.runs);
+        fputc('\n', out);
+    }
+    return ferror(out) ? -1 : 0;
+}
+
+/**
+ * @brief Write a folded stack for every statement with work under prefix
+ */
+static void fold(dc_context *ctx, int s, std::string *prefix, FILE *out)
+{
+    const size_t n = ctx->ast.stmts.size();
+    for (; s >= 0; s = ctx->ast.stmts[s].next)
+    {
+        const dc_stmt &st = ctx->ast.stmts[s];
+        size_t keep = prefix->size();
+        if (!prefix->empty())
+            *prefix += ';';
+        *prefix += kindOf(ctx, s) + "@" + position(ctx, s);
+        unsigned long long self = st.kind == KEY_DO ? ctx->hits[n + s]
+                                  : st.kind == KEY_PAR ? 0
+                                                       : ctx->hits[s];
+        if (self)
+            fprintf(out, "%s %llu\n", prefix->c_str(), self);
+        if (ctx->hits[s])
+            fold(ctx, st.body, prefix, out);
+        prefix->resize(keep);
+    }
+}
+
+int dc_profile_folded(dc_context *ctx, FILE *out)
+{
+    if (ctx->hits.empty())
+        return -1;
+    std::string prefix;
+    fold(ctx, ctx->ast.first, &prefix, out);
+    return ferror(out) ? -1 : 0;
+}
@@ -0,0 +1,39 @@
+/*
+=============================================================================
+Title : sha256.h
+Description : SHA-256 (FIPS 180-4) for the token digest of dc_format.
+Author : silrodri (R#11679913)
+Date : 10/19/2026
+Version : 2.0
+Usage : Internal to libdcooke; shaBegin, any number of shaAdd, shaEnd
+Notes : Plain portable code, one 64-byte block at a time. It is only run
+        where a result is looked up by the digest, so speed matters less
+        than not needing a crypto library.
+C++ Version : cpp (GCC) 4.8.5 20150623 (Red Hat 4.8.5-16)
+=============================================================================
+*/
+#ifndef SHA256_H
+#define SHA256_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define DC_SHA256_BYTES 32
+
+/**
+ * @brief : Running state: the chaining words, the partial block and the
+ *  total length so far
+ */
+struct dc_sha256
+{
+    uint32_t h[8];
+    unsigned char block[64];
+    size_t used; // bytes of block filled
+    uint64_t total;
+};
+
+void shaBegin(dc_sha256 *s);
+void shaAdd(dc_sha256 *s, const void *data, size_t len);
+void shaEnd(dc_sha256 *s, unsigned char digest[DC_SHA256_BYTES]);
+
+#endif
@@ -0,0 +1,349 @@
+/*
+=============================================================================
+Title : stream.cpp
+Description : Streamed file input with transparent gzip/zstd decompression
+              (dc_stream_*).
+Author : silrodri (R#11679913)
+Date : 10/19/2026
+Version : 2.0
+Usage : Built into libdcooke; see dc_stream_open() in dcooke.h
+Notes : A reader thread reads the file, inflates it when the first bytes
+        are a gzip or zstd magic number, and fills a small ring of buffers.
+        The lexer pulls a buffer whenever it runs out of input, so reading
+        and decompression overlap with scanning and parsing. Each buffer is
+        cut at its last token boundary, so no token straddles two of them,
+        and input without blanks streams too. dc_stream_load() runs the
+        same reader on the calling thread, with no limit on the ring, and
+        returns once the whole file is in it.
+        zstd needs a build with -DDC_HAVE_ZSTD (make ZSTD=1).
+C++ Version : cpp (GCC) 4.8.5 20150623 (Red Hat 4.8.5-16)
+=============================================================================
+*/
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// build with -DDC_NO_ZLIB where <zlib.h> is unavailable
+#ifndef DC_NO_ZLIB
+#include <zlib.h>
+#define DC_HAVE_ZLIB 1
+#endif
+#ifdef DC_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+#include "context.h"
+
+#define RING_SLOTS 4
+#define CHUNK 262144   // bytes handed to the lexer at a time
+#define READ_SIZE 65536
+
+struct dc_stream
+{
+    FILE *fp;
+    std::thread reader;
+
+    /* filled buffers; the reader waits while 'limit' of them are queued */
+    std::mutex lock;
+    std::condition_variable filled, drained;
+    std::deque<std::vector<char> > slots;
+    size_t limit;
+    bool done, stop;
+    std::string error;
+
+    /* reader side: decompressed bytes not yet cut into a slot */
+    std::vector<char> pending;
+    size_t scanned; // pending[0, scanned) holds no cut point
+    size_t delivered;
+};
+
+static bool isBlank(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+}
+
+static bool isWord(char c)
+{
+    return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9');
+}
+
+/**
+ * @brief Whether a then b can be inside one token: IDENT, INT_LIT and the
+ *  keywords, ++ --, and == != <= >= (keep in step with tokens.spec)
+ */
+static bool joins(char a, char b)
+{
+    if (isWord(a) && isWord(b))
+        return true;
+    if (b == '=')
+        return a == '=' || a == '!' || a == '<' || a == '>';
+    return a == b && (a == '+' || a == '-');
+}
+
+/**
+ * @brief Queue the pending bytes up to the last token boundary (all of
+ *  them at the end of the input); false once the stream is being closed
+ */
+static bool publish(dc_stream *s, bool last)
+{
+    std::vector<char> &p = s->pending;
+    size_t cut = p.size();
+    // a cut before p[c]; the end only after a blank, since the next byte
+    // is unknown. Positions already looked at are not looked at again
+    if (!last && !(cut > 0 && isBlank(p[cut - 1])))
+    {
+        size_t lo = std::max(s->scanned, (size_t)1);
+        for (cut = p.size() - 1; cut >= lo && joins(p[cut - 1], p[cut]) && !isBlank(p[cut - 1]);)
+            cut--;
+        if (cut < lo)
+            cut = 0;
+    }
+    if (cut == 0)
+    {
+        s->scanned = p.size();
+        return true; // one token longer than the buffer: keep reading
+    }
+
+    std::unique_lock<std::mutex> hold(s->lock);
+    while (s->slots.size() >= s->limit && !s->stop)
+        s->drained.wait(hold);
+    if (s->stop)
+        return false;
+    s->slots.push_back(std::vector<char>());
+    s->slots.back().assign(s->pending.begin(), s->pending.begin() + cut);
+    hold.unlock();
+    s->filled.notify_one();
+    p.erase(p.begin(), p.begin() + cut);
+    s->scanned = p.size();
+    return true;
+}
+
+/**
+ * @brief Append decoded bytes; publish whenever a chunk has built up
+ */
+static bool produce(dc_stream *s, const char *data, size_t len)
+{
+    s->pending.insert(s->pending.end(), data, data + len);
+    return s->pending.size() < CHUNK || publish(s, false);
+}
+
+static void copyPlain(dc_stream *s, char *in, size_t have)
+{
+    do
+    {
+        if (!produce(s, in, have))
+            return;
+    } while ((have = fread(in, 1, READ_SIZE, s->fp)) > 0);
+}
+
+#ifdef DC_HAVE_ZLIB
+static void inflateGzip(dc_stream *s, char *in, size_t have)
+{
+    std::vector<char> out(READ_SIZE);
+    z_stream z;
+    memset(&z, 0, sizeof z);
+    // 15 + 32: any window size, gzip or zlib header detected
+    if (inflateInit2(&z, 15 + 32) != Z_OK)
+    {
+        s->error = "cannot start zlib";
+        return;
+    }
+    int rc = Z_OK;
+    for (;;)
+    {
+        z.next_in = (Bytef *)in;
+        z.avail_in = (uInt)have;
+        do
+        {
+            // concatenated gzip members are one stream
+            if (rc == Z_STREAM_END)
+            {
+                if (z.avail_in == 0)
+                    break;
+                inflateReset(&z);
+            }
+            z.next_out = (Bytef *)out.data();
+            z.avail_out = (uInt)out.size();
+            rc = inflate(&z, Z_NO_FLUSH);
+            if (rc != Z_OK && rc != Z_STREAM_END && rc != Z_BUF_ERROR)
+            {
+                s->error = std::string("corrupt gzip data: ") + (z.msg ? z.msg : "inflate failed");
+                inflateEnd(&z);
+                return;
+            }
+            if (!produce(s, out.data(), out.size() - z.avail_out))
+            {
+                inflateEnd(&z);
+                return;
+            }
+        } while (z.avail_out == 0 || (rc == Z_STREAM_END && z.avail_in > 0));
+        if ((have = fread(in, 1, READ_SIZE, s->fp)) == 0)
+            break;
+    }
+    if (rc != Z_STREAM_END)
+        s->error = "truncated gzip data";
+    inflateEnd(&z);
+}
+#endif
+
+#ifdef DC_HAVE_ZSTD
+static void inflateZstd(dc_stream *s, char *in, size_t have)
+{
+    std::vector<char> out(ZSTD_DStreamOutSize());
+    ZSTD_DStream *z = ZSTD_createDStream();
+    size_t rc = 1;
+    if (z == nullptr || ZSTD_isError(ZSTD_initDStream(z)))
+    {
+        s->error = "cannot start zstd";
+        ZSTD_freeDStream(z);
+        return;
+    }
+    do
+    {
+        ZSTD_inBuffer ib = {in, have, 0};
+        bool full;
+        do
+        {
+            ZSTD_outBuffer ob = {out.data(), out.size(), 0};
+            rc = ZSTD_decompressStream(z, &ob, &ib);
+            if (ZSTD_isError(rc))
+            {
+                s->error = std::string("corrupt zstd data: ") + ZSTD_getErrorName(rc);
+                ZSTD_freeDStream(z);
+                return;
+            }
+            if (!produce(s, out.data(), ob.pos))
+            {
+                ZSTD_freeDStream(z);
+                return;
+            }
+            // a full buffer may leave output inside the decoder
+            full = ob.pos == ob.size;
+        } while (ib.pos < ib.size || full);
+    } while ((have = fread(in, 1, READ_SIZE, s->fp)) > 0);
+    // rc is 0 exactly when the last frame was complete
+    if (rc != 0)
+        s->error = "truncated zstd data";
+    ZSTD_freeDStream(z);
+}
+#endif
+
+/**
+ * @brief Reader thread: sniff the format, decode the file, close the ring
+ */
+static void readAll(dc_stream *s)
+{
+    std::vector<char> in(READ_SIZE);
+    size_t have = fread(in.data(), 1, in.size(), s->fp);
+    const unsigned char *m = (const unsigned char *)in.data();
+
+    if (have >= 2 && m[0] == 0x1f && m[1] == 0x8b)
+    {
+#ifdef DC_HAVE_ZLIB
+        inflateGzip(s, in.data(), have);
+#else
+        s->error = "gzip input needs libdcooke built with zlib";
+#endif
+    }
+    else if (have >= 4 && m[0] == 0x28 && m[1] == 0xb5 && m[2] == 0x2f && m[3] == 0xfd)
+    {
+#ifdef DC_HAVE_ZSTD
+        inflateZstd(s, in.data(), have);
+#else
+        s->error = "zstd input needs libdcooke built with ZSTD=1";
+#endif
+    }
+    else if (have > 0)
+        copyPlain(s, in.data(), have);
+    if (ferror(s->fp) && s->error.empty())
+        s->error = strerror(errno);
+
+    if (s->error.empty())
+        publish(s, true);
+    {
+        std::lock_guard<std::mutex> hold(s->lock);
+        s->done = true;
+    }
+    s->filled.notify_one();
+}
+
+static dc_stream *create(const char *path, size_t limit)
+{
+    FILE *fp = fopen(path, "rb");
+    if (fp == nullptr)
+        return nullptr;
+    dc_stream *s = new dc_stream();
+    s->fp = fp;
+    s->limit = limit;
+    s->done = s->stop = false;
+    s->scanned = s->delivered = 0;
+    return s;
+}
+
+dc_stream *dc_stream_open(const char *path)
+{
+    dc_stream *s = create(path, RING_SLOTS);
+    if (s != nullptr)
+        s->reader = std::thread(readAll, s);
+    return s;
+}
+
+dc_stream *dc_stream_load(const char *path)
+{
+    dc_stream *s = create(path, (size_t)-1);
+    if (s != nullptr)
+        readAll(s);
+    return s;
+}
+
+int dc_stream_pull(void *stream, dc_context *ctx)
+{
+    dc_stream *s = (dc_stream *)stream;
+    std::vector<char> slot;
+    {
+        std::unique_lock<std::mutex> hold(s->lock);
+        while (s->slots.empty() && !s->done)
+            s->filled.wait(hold);
+        if (s->slots.empty())
+            return -1;
+        slot.swap(s->slots.front());
+        s->slots.pop_front();
+    }
+    s->drained.notify_one();
+    s->delivered += slot.size();
+    return dc_feed(ctx, slot.data(), slot.size());
+}
+
+size_t dc_stream_bytes(const dc_stream *stream)
+{
+    return stream->delivered;
+}
+
+const char *dc_stream_error(dc_stream *stream)
+{
+    std::lock_guard<std::mutex> hold(stream->lock);
+    // only final once the reader has finished
+    if (!stream->done || stream->error.empty())
+        return nullptr;
+    return stream->error.c_str();
+}
+
+void dc_stream_close(dc_stream *stream)
+{
+    {
+        std::lock_guard<std::mutex> hold(stream->lock);
+        stream->stop = true;
+    }
+    stream->drained.notify_one();
+    if (stream->reader.joinable())
+        stream->reader.join();
+    fclose(stream->fp);
+    delete stream;
+}
@@ -0,0 +1,110 @@
+/*
+=============================================================================
+Title : symtab.cpp
+Description : Identifier interner that gives each distinct IDENT a dense ID.
+Author : silrodri (R#11679913)
+Date : 10/19/2026
+Version : 2.0
+Usage : Built into libdcooke; see symtab.h
+Notes : The table is kept at most half full and doubles when it gets there,
+        so probes stay short even with tens of thousands of identifiers.
+C++ Version : cpp (GCC) 4.8.5 20150623 (Red Hat 4.8.5-16)
+=============================================================================
+*/
+#include <algorithm>
+#include <cstring>
+
+#include "symtab.h"
+
+/**
+ * @brief FNV-1a hash of an identifier slice
+ */
+static uint32_t hashSlice(const char *p, size_t len)
+{
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < len; i++)
+    {
+        h ^= (unsigned char)p[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/**
+ * @brief Rebuild the slot array with cap slots
+ */
+static void rehash(dc_symtab *tab, size_t cap)
+{
+    size_t mask = cap - 1;
+
+    tab->slots.assign(cap, 0);
+    for (size_t id = 0; id < tab->syms.size(); id++)
+    {
+        size_t i = tab->syms[id].hash & mask;
+        while (tab->slots[i] != 0)
+            i = (i + 1) & mask;
+        tab->slots[i] = (uint32_t)id + 1;
+    }
+}
+
+static void grow(dc_symtab *tab)
+{
+    rehash(tab, tab->slots.empty() ? 64 : tab->slots.size() * 2);
+}
+
+/**
+ * @brief Forget every symbol but keep the allocated capacity
+ */
+void symClear(dc_symtab *tab)
+{
+    std::fill(tab->slots.begin(), tab->slots.end(), 0);
+    tab->syms.clear();
+    tab->names.clear();
+}
+
+/**
+ * @brief Forget the symbols whose IDs are count and above
+ */
+void symTruncate(dc_symtab *tab, size_t count)
+{
+    if (count >= tab->syms.size())
+        return;
+    tab->names.resize(tab->syms[count].nameAt);
+    tab->syms.resize(count);
+    rehash(tab, tab->slots.size());
+}
+
+/**
+ * @brief Return the dense ID of src[start, start + len), adding it if new
+ */
+int symIntern(dc_symtab *tab, const std::vector<char> &src, size_t start, size_t len)
+{
+    const char *text = &src[start];
+    uint32_t h = hashSlice(text, len);
+
+    if ((tab->syms.size() + 1) * 2 > tab->slots.size())
+        grow(tab);
+
+    size_t mask = tab->slots.size() - 1;
+    size_t i = h & mask;
+    while (tab->slots[i] != 0)
+    {
+        const dc_symbol &sym = tab->syms[tab->slots[i] - 1];
+        if (sym.hash == h && sym.len == len &&
+            memcmp(&src[sym.start], text, len) == 0)
+            return (int)tab->slots[i] - 1;
+        i = (i + 1) & mask;
+    }
+
+    // new identifier: take the next dense ID
+    dc_symbol sym;
+    sym.start = start;
+    sym.len = (uint32_t)len;
+    sym.hash = h;
+    sym.nameAt = tab->names.size();
+    tab->names.insert(tab->names.end(), text, text + len);
+    tab->names.push_back(0);
+    tab->syms.push_back(sym);
+    tab->slots[i] = (uint32_t)tab->syms.size();
+    return (int)tab->syms.size() - 1;
+}
@@ -0,0 +1,43 @@
+/*
+=============================================================================
+Title : symtab.h
+Description : Identifier interner that gives each distinct IDENT a dense ID.
+Author : silrodri (R#11679913)
+Date : 10/19/2026
+Version : 2.0
+Usage : Internal to libdcooke; filled by lex() as identifiers are scanned
+Notes : Open addressing with linear probing over slices of the source
+        buffer, so interning an identifier never copies it until it is new.
+C++ Version : cpp (GCC) 4.8.5 20150623 (Red Hat 4.8.5-16)
+=============================================================================
+*/
+#ifndef SYMTAB_H
+#define SYMTAB_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+/**
+ * @brief : One distinct identifier; its text is src[start, start + len)
+ */
+struct dc_symbol
+{
+    size_t start;
+    uint32_t len;
+    uint32_t hash;
+    size_t nameAt; // NUL-terminated copy in dc_symtab::names (for the C API)
+};
+
+struct dc_symtab
+{
+    std::vector<uint32_t> slots; // symbol ID + 1, 0 marks an empty slot
+    std::vector<dc_symbol> syms; // indexed by symbol ID
+    std::vector<char> names;
+};
+
+void symClear(dc_symtab *tab);
+void symTruncate(dc_symtab *tab, size_t count);
+int symIntern(dc_symtab *tab, const std::vector<char> &src, size_t start, size_t len);
+
+#endif
@@ -0,0 +1,46 @@
+# =============================================================================
+# Title : tokens.spec
+# Description : Token specification of the DCooke language.
+# Author : silrodri (R#11679913)
+# Date : 10/19/2026
+# Version : 2.0
+# Usage : lexgen turns this file into lexer_dfa.h (see makefile)
+# Notes : One rule per line: TOKEN followed by a pattern. A pattern is a
+#         sequence of "strings" and [sets], and a set may be followed by
+#         * + or ?. The longest match wins, and on a tie the earlier rule
+#         wins, so keywords come before IDENT. A byte that starts no rule
+#         is a one-byte UNKNOWN token. %skip lists the blanks between
+#         tokens. A new token needs a code in front.h and a line here.
+# =============================================================================
+
+%skip       [ \t\n\v\f\r]
+
+KEY_READ    "read"
+KEY_WRITE   "write"
+KEY_WHILE   "while"
+KEY_DO      "do"
+KEY_PAR     "par"
+
+LEFT_PAREN  "("
+RIGHT_PAREN ")"
+LEFT_CBRACE "{"
+RIGHT_CBRACE "}"
+SEMICOLON   ";"
+
+INC_OP      "++"
+DEC_OP      "--"
+ADD_OP      "+"
+SUB_OP      "-"
+MULT_OP     "*"
+DIV_OP      "/"
+
+ASSIGN_OP   "="
+EQUAL_OP    "=="
+NEQUAL_OP   "!="
+LESSER_OP   "<"
+GREATER_OP  ">"
+LEQUAL_OP   "<="
+GEQUAL_OP   ">="
+
+IDENT       [A-Za-z][A-Za-z0-9]*
+INT_LIT     [0-9]+
@@ -0,0 +1,171 @@
+/*
+=============================================================================
+Title : uninit.cpp
+Description : Use-before-definition warnings (dc_warn_uninit) and the
+              early reads dc_analyze joins 0 in for.
+Author : silrodri (R#11679913)
+Date : 10/19/2026
+Version : 2.0
+Usage : Built into libdcooke; run after a successful dc_parse()
+Notes : Two forward "may" problems over the CFG, one bit per variable:
+        maybeUndef (entry: all set, a write clears the bit) and maybeDef
+        (entry: all clear, a write sets the bit). A read whose maybeUndef
+        bit is set is reported; if maybeDef is also clear no write can
+        reach it at all. Blocks are visited in program order from a
+        worklist, so each loop nest settles in a few sweeps.
+C++ Version : cpp (GCC) 4.8.5 20150623 (Red Hat 4.8.5-16)
+=============================================================================
+*/
+#include <deque>
+#include <stdint.h>
+
+#include "cfg.h"
+#include "context.h"
+
+/**
+ * @brief Union the out-sets of the predecessors of block b into the in-sets;
+ *  the entry block starts with every variable undefined
+ */
+static void meet(size_t b, size_t words, const std::vector<std::vector<int> > &preds,
+                 const std::vector<uint64_t> &undefOut, const std::vector<uint64_t> &defOut,
+                 std::vector<uint64_t> *undefIn, std::vector<uint64_t> *defIn)
+{
+    for (size_t w = 0; w < words; w++)
+    {
+        (*undefIn)[w] = b == 0 ? ~0ULL : 0;
+        (*defIn)[w] = 0;
+    }
+    for (size_t p = 0; p < preds[b].size(); p++)
+    {
+        const uint64_t *u = &undefOut[preds[b][p] * words];
+        const uint64_t *d = &defOut[preds[b][p] * words];
+        for (size_t w = 0; w < words; w++)
+        {
+            (*undefIn)[w] |= u[w];
+            (*defIn)[w] |= d[w];
+        }
+    }
+}
+
+/**
+ * @brief Find, for every variable, the first read in program order that may
+ *  run before any assignment to it; order (may be NULL) gets the variables
+ *  in the order their reads were found
+ */
+void earlyReads(const dc_ast *ast, size_t nsyms, std::vector<dc_early> *early,
+                std::vector<int> *order)
+{
+    dc_early none = {false, false, 0};
+    early->assign(nsyms, none);
+    if (nsyms == 0)
+        return;
+
+    dc_cfg cfg;
+    buildCfg(ast, &cfg);
+
+    const size_t nb = cfg.blocks.size();
+    const size_t words = (nsyms + 63) / 64;
+    // flat packed bitsets, 'words' 64-bit words per block
+    std::vector<uint64_t> kill(nb * words, 0);
+    std::vector<uint64_t> undefOut(nb * words, 0), defOut(nb * words, 0);
+    std::vector<uint64_t> undefIn(words), defIn(words);
+    std::vector<std::vector<int> > preds(nb);
+
+    for (size_t b = 0; b < nb; b++)
+    {
+        const dc_block &blk = cfg.blocks[b];
+        for (size_t e = blk.firstEvent; e < blk.endEvent; e++)
+            if (cfg.events[e].kind == DC_EV_DEF)
+                kill[b * words + cfg.events[e].symbol / 64] |=
+                    1ULL << (cfg.events[e].symbol % 64);
+        for (int k = 0; k < 2; k++)
+            if (blk.succ[k] >= 0)
+                preds[blk.succ[k]].push_back((int)b);
+    }
+
+    std::deque<int> work;
+    std::vector<char> queued(nb, 1);
+    for (size_t b = 0; b < nb; b++)
+        work.push_back((int)b);
+    while (!work.empty())
+    {
+        int b = work.front();
+        work.pop_front();
+        queued[b] = 0;
+        meet(b, words, preds, undefOut, defOut, &undefIn, &defIn);
+
+        bool changed = false;
+        for (size_t w = 0; w < words; w++)
+        {
+            uint64_t u = undefIn[w] & ~kill[b * words + w];
+            uint64_t d = defIn[w] | kill[b * words + w];
+            if (u != undefOut[b * words + w] || d != defOut[b * words + w])
+            {
+                undefOut[b * words + w] = u;
+                defOut[b * words + w] = d;
+                changed = true;
+            }
+        }
+        if (!changed)
+            continue;
+        for (int k = 0; k < 2; k++)
+        {
+            int s = cfg.blocks[b].succ[k];
+            if (s >= 0 && !queued[s])
+            {
+                queued[s] = 1;
+                work.push_back(s);
+            }
+        }
+    }
+
+    // replay each block in order and keep the first flagged read
+    for (size_t b = 0; b < nb; b++)
+    {
+        meet(b, words, preds, undefOut, defOut, &undefIn, &defIn);
+        const dc_block &blk = cfg.blocks[b];
+        for (size_t e = blk.firstEvent; e < blk.endEvent; e++)
+        {
+            const dc_event &ev = cfg.events[e];
+            uint64_t bit = 1ULL << (ev.symbol % 64);
+            dc_early &first = (*early)[ev.symbol];
+            if (ev.kind == DC_EV_DEF)
+            {
+                undefIn[ev.symbol / 64] &= ~bit;
+                defIn[ev.symbol / 64] |= bit;
+            }
+            else if ((undefIn[ev.symbol / 64] & bit) && !first.found)
+            {
+                first.found = true;
+                first.reached = (defIn[ev.symbol / 64] & bit) != 0;
+                first.offset = ev.offset;
+                if (order)
+                    order->push_back(ev.symbol);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Warn about every variable read that may run before it is assigned
+ * @return int : number of warnings added
+ */
+int dc_warn_uninit(dc_context *ctx)
+{
+    if (ctx->exit_code != NoError || ctx->symbols.syms.empty())
+        return 0;
+
+    std::vector<dc_early> early;
+    std::vector<int> order;
+    earlyReads(&ctx->ast, ctx->symbols.syms.size(), &early, &order);
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        const dc_early &first = early[order[i]];
+        std::string message = std::string("warning: '") + dc_symbol_name(ctx, order[i]) +
+                              (first.reached ? "' may be used" : "' is used") +
+                              " before it is assigned";
+        where(ctx, first.offset, &message);
+        report(ctx, DC_DIAG_WARNING, message, first.offset);
+    }
+    return (int)order.size();
+}